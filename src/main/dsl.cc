@@ -19,13 +19,17 @@
 
 #include "dsl.h"
 
+#include <filesystem>
 #include <fstream>
 #include <functional>
 #include <iostream>
-#include <numeric>
+#include <limits>
+#include <map>
 #include <optional>
+#include <random>
 #include <utility>
 
+#include "model/cache.h"
 #include "model/component/aura.h"
 #include "model/component/auxiliary.h"
 #include "model/component/componentSet.h"
@@ -39,8 +43,15 @@
 #include "model/component/utility.h"
 #include "model/component/weapon.h"
 #include "model/design/fleet.h"
+#include "model/design/shipRegistry.h"
 #include "model/evaluator.h"
+#include "model/isa.h"
+#include "model/loadout.h"
+#include "model/racing.h"
+#include "model/rating.h"
+#include "model/sequential.h"
 #include "nlohmann/json.hpp"
+#include "util/hash.h"
 #include "util/json.h"
 #include "version.h"
 
@@ -77,75 +88,306 @@ class Header final {
   bool finished;
 };
 
+/**
+ * tier from a component file's name, like the 3 in 3_cruiser.json; zero if it
+ * doesn't have one
+ */
+unsigned tierOf(string const &filename) {
+  string name = filesystem::path(filename).filename().string();
+  size_t digits = name.find_first_not_of("0123456789");
+  if (digits == 0 || digits > 9 || digits == string::npos ||
+      name[digits] != '_')
+    return 0;
+  return static_cast<unsigned>(stoul(name.substr(0, digits)));
+}
+
+/**
+ * reads a component file's top-level name, stopping as soon as it's found
+ */
+class NameReader final : public json_sax<json> {
+ public:
+  optional<string_t> name;
+
+  bool null() override { return value(); }
+  bool boolean(bool) override { return value(); }
+  bool number_integer(number_integer_t) override { return value(); }
+  bool number_unsigned(number_unsigned_t) override { return value(); }
+  bool number_float(number_float_t, string_t const &) override {
+    return value();
+  }
+  bool string(string_t &text) override {
+    if (depth == 1 && atName) {
+      name = text;
+      return false;
+    }
+    return value();
+  }
+  bool binary(binary_t &) override { return value(); }
+  bool start_object(size_t) override {
+    ++depth;
+    return true;
+  }
+  bool key(string_t &key) override {
+    if (depth == 1) atName = key == "name";
+    return true;
+  }
+  bool end_object() override {
+    --depth;
+    return value();
+  }
+  bool start_array(size_t) override {
+    ++depth;
+    return true;
+  }
+  bool end_array() override {
+    --depth;
+    return value();
+  }
+  bool parse_error(size_t, std::string const &,
+                   detail::exception const &) override {
+    return false;
+  }
+
+ private:
+  size_t depth = 0;
+  bool atName = false;
+
+  bool value() noexcept {
+    if (depth == 1) atName = false;
+    return true;
+  }
+};
+
+template <typename T>
+pair<T, uint64_t> readComponent(
+    string const &filename,
+    function<T(json const &, EvalContext &)> const &fromJson,
+    EvalContext &ctx) {
+  ifstream file(filename);
+  if (!file) ctx.error("could not open file");
+  json data = parse(file, ctx);
+  // keys are sorted, so equal data dumps identically
+  return {fromJson(data, ctx), hashBytes(data.dump())};
+}
 template <typename T>
 void loadComponentsOfType(
     ComponentSet &components, json const &load, string const &key,
-    function<T(json const &, EvalContext &)> const &fromJson,
+    function<T(json const &, EvalContext &)> const &fromJson, bool lazy,
     EvalContext &ctx) {
   vector<string> componentFiles = checkStringArray(load, key, ctx);
   auto _ = ctx.push(key);
-  for_each(componentFiles.begin(), componentFiles.end(),
-           [&ctx, &components, &fromJson](string const &filename) {
-             auto _ = ctx.push(filename);
-             ifstream file(filename);
-             if (!file) ctx.error("could not open file");
-             components.add(fromJson(parse(file, ctx), ctx), ctx);
-           });
+  for_each(
+      componentFiles.begin(), componentFiles.end(),
+      [&ctx, &components, &key, &fromJson, lazy](string const &filename) {
+        auto _ = ctx.push(filename);
+        if (lazy) {
+          // components without a readable name are loaded now, which reports
+          // what's wrong with them
+          ifstream file(filename);
+          NameReader reader;
+          if (file) json::sax_parse(file, &reader);
+          if (reader.name) {
+            // errors come up where the component is first used, so say where
+            // it was loaded from too
+            components.defer(
+                *reader.name,
+                ComponentSet::Loader<T>([&ctx, key, filename, fromJson]() {
+                  auto loadScope = ctx.push("load");
+                  auto keyScope = ctx.push(key);
+                  auto fileScope = ctx.push(filename);
+                  return readComponent(filename, fromJson, ctx);
+                }),
+                ctx, tierOf(filename));
+            return;
+          }
+        }
+        auto [component, hash] = readComponent(filename, fromJson, ctx);
+        components.add(move(component), ctx, hash, tierOf(filename));
+      });
 }
 ComponentSet loadComponents(json const &load, EvalContext &ctx) {
   ComponentSet components;
-  loadComponentsOfType<Hull>(components, load, "hulls", Hull::fromJson, ctx);
+  bool lazy = checkMaybeBool(load, "lazy", ctx).value_or(false);
+  loadComponentsOfType<Hull>(components, load, "hulls", Hull::fromJson, lazy,
+                             ctx);
   loadComponentsOfType<athena2::model::component::Section>(
       components, load, "sections",
-      athena2::model::component::Section::fromJson, ctx);
+      athena2::model::component::Section::fromJson, lazy, ctx);
   loadComponentsOfType<Reactor>(components, load, "reactors", Reactor::fromJson,
-                                ctx);
-  loadComponentsOfType<FTL>(components, load, "ftls", FTL::fromJson, ctx);
+                                lazy, ctx);
+  loadComponentsOfType<FTL>(components, load, "ftls", FTL::fromJson, lazy,
+                            ctx);
   loadComponentsOfType<Sublight>(components, load, "sublights",
-                                 Sublight::fromJson, ctx);
+                                 Sublight::fromJson, lazy, ctx);
   loadComponentsOfType<Sensor>(components, load, "sensors", Sensor::fromJson,
-                               ctx);
+                               lazy, ctx);
   loadComponentsOfType<Computer>(components, load, "computers",
-                                 Computer::fromJson, ctx);
-  loadComponentsOfType<Aura>(components, load, "auras", Aura::fromJson, ctx);
+                                 Computer::fromJson, lazy, ctx);
+  loadComponentsOfType<Aura>(components, load, "auras", Aura::fromJson, lazy,
+                             ctx);
   loadComponentsOfType<Utility>(components, load, "utilities",
-                                Utility::fromJson, ctx);
+                                Utility::fromJson, lazy, ctx);
   loadComponentsOfType<Auxiliary>(components, load, "auxiliaries",
-                                  Auxiliary::fromJson, ctx);
+                                  Auxiliary::fromJson, lazy, ctx);
   loadComponentsOfType<Weapon>(components, load, "weapons", Weapon::fromJson,
-                               ctx);
+                               lazy, ctx);
   checkFields(load,
-              {"hulls", "sections", "reactors", "ftls", "sublights", "sensors",
-               "computers", "auras", "utilities", "auxiliaries", "weapons"},
+              {"lazy", "hulls", "sections", "reactors", "ftls", "sublights",
+               "sensors", "computers", "auras", "utilities", "auxiliaries",
+               "weapons"},
               ctx);
   return components;
 }
+void printResult(Fleet const &first, Fleet const &second,
+                 EvaluationResult const &result) {
+  cout << first.name << ": " << -result.firstLoss << "/" << first.cost << ", "
+       << second.name << ": " << -result.secondLoss << "/" << second.cost;
+  if (result.truncated) cout << " (stopped early)";
+  if (result.firstLoss < result.secondLoss) {
+    cout << "; " << first.name << " wins by "
+         << result.secondLoss - result.firstLoss << "\n";
+  } else if (result.secondLoss < result.firstLoss) {
+    cout << "; " << second.name << " wins by "
+         << result.firstLoss - result.secondLoss << "\n";
+  } else {
+    cout << "; draw\n";
+  }
+}
+void printResult(Fleet const &first, Fleet const &second,
+                 SequentialResult const &result) {
+  cout << first.name << ": " << -result.mean.firstLoss << "/" << first.cost
+       << ", " << second.name << ": " << -result.mean.secondLoss << "/"
+       << second.cost << "; ";
+  switch (result.verdict) {
+    case SequentialResult::Verdict::FIRST: {
+      cout << first.name << " wins";
+      break;
+    }
+    case SequentialResult::Verdict::SECOND: {
+      cout << second.name << " wins";
+      break;
+    }
+    case SequentialResult::Verdict::DRAW: {
+      cout << "draw";
+      break;
+    }
+    case SequentialResult::Verdict::UNDECIDED: {
+      cout << "undecided";
+      break;
+    }
+  }
+  cout << " after " << result.fights << " fights\n";
+}
+void printLoadouts(vector<SectionLoadouts> const &sections) {
+  for (SectionLoadouts const &loadouts : sections) {
+    cout << loadouts.section->name << ":\n";
+    for (SlotGroup const &group : loadouts.groups) {
+      cout << "  " << group.slots << " " << group.size
+           << (group.weapon ? " weapon" : " utility") << " slot"
+           << (group.slots == 1 ? "" : "s") << ": ";
+      if (group.enumerated)
+        cout << group.fillings.size() << " of " << group.candidates()
+             << " fillings\n";
+      else
+        cout << group.candidates() << " fillings, too many to enumerate\n";
+    }
+  }
+}
+void printRanking(vector<Fleet> const &fleets, RacingResult const &result) {
+  for (size_t rank = 0; rank < result.ranking.size(); ++rank) {
+    size_t idx = result.ranking[rank];
+    cout << rank + 1 << ". " << fleets[idx].name << ": " << result.scores[idx]
+         << " net per fight after " << result.fights[idx] << " fights\n";
+  }
+  if (result.stoppedEarly) cout << "(stopped early: budget ran out)\n";
+}
+void rate(vector<Fleet> const &fleets, optional<string> const &ratingsFile,
+          optional<size_t> const &rounds, EvaluationSettings const &settings,
+          ResultCache *cache, FirePool &firePool, EvalContext &ctx) {
+  // existing ratings carry over; a missing file starts a new table
+  map<string, Rating> table;
+  if (ratingsFile) {
+    ifstream in(*ratingsFile);
+    if (in) {
+      auto _ = ctx.push(*ratingsFile);
+      json tableData = parse(in, ctx);
+      checkObject(tableData, ctx);
+      for (auto const &[key, val] : tableData.items()) {
+        auto _ = ctx.push(key);
+        table.emplace(key, Rating::fromJson(val, ctx));
+      }
+    }
+  }
+
+  vector<Fleet const *> pool;
+  vector<Rating> ratings;
+  for (Fleet const &fleet : fleets) {
+    pool.push_back(&fleet);
+    auto found = table.find(fleet.name);
+    ratings.push_back(found == table.end() ? INITIAL_RATING : found->second);
+  }
+  playSwiss(pool, ratings, settings, rounds.value_or(swissRounds(pool.size())),
+            firePool, cache);
+  for (size_t idx = 0; idx < pool.size(); ++idx)
+    table.insert_or_assign(pool[idx]->name, ratings[idx]);
+
+  vector<pair<string, Rating>> ranking(table.begin(), table.end());
+  stable_sort(ranking.begin(), ranking.end(),
+              [](pair<string, Rating> const &lhs,
+                 pair<string, Rating> const &rhs) {
+                return lhs.second.rating > rhs.second.rating;
+              });
+  for (size_t rank = 0; rank < ranking.size(); ++rank) {
+    auto const &[name, rating] = ranking[rank];
+    cout << rank + 1 << ". " << name << ": " << rating.rating << " +/- "
+         << 2.f * rating.deviation << " after " << rating.fights
+         << " fights\n";
+  }
+
+  if (ratingsFile) {
+    ofstream out(*ratingsFile);
+    if (!out) {
+      auto _ = ctx.push(*ratingsFile);
+      ctx.error("could not write file");
+    }
+    out << static_cast<json>(table).dump(2) << "\n";
+  }
+}
 }  // namespace
 
-EvalContext::EvalContext(string const &root) noexcept : contextStack(1, root) {}
+EvalContext::EvalContext(string const &root) noexcept : path(root) {
+  path.reserve(256);
+}
 [[noreturn]] void EvalContext::error(string const &message) {
-  string accumulator = "Error: ";
-  string context = accumulate(
-      contextStack.begin(), contextStack.end(), ""s,
-      [](string const &a, string const &b) { return a + " > " + b; });
-  accumulator += context.substr(3);
-  accumulator += ": ";
-  accumulator += message;
-  throw EvalException(accumulator);
+  throw EvalException("Error: " + path + ": " + message);
 }
-EvalContext::ScopeGuard EvalContext::push(string const &name) noexcept {
-  contextStack.push_back(name);
-  return EvalContext::ScopeGuard([this] { contextStack.pop_back(); });
+EvalContext::ScopeGuard EvalContext::push(string_view name) {
+  size_t length = path.size();
+  path += " > ";
+  path += name;
+  return EvalContext::ScopeGuard(*this, length);
 }
 
-EvalContext::ScopeGuard::ScopeGuard(function<void()> const &f_) noexcept
-    : f(f_) {}
-EvalContext::ScopeGuard::~ScopeGuard() noexcept {
-  if (f) f();
+EvalContext::ScopeGuard::ScopeGuard(EvalContext &ctx_, size_t length_) noexcept
+    : ctx(&ctx_), length(length_) {}
+EvalContext::ScopeGuard::ScopeGuard(ScopeGuard &&other) noexcept
+    : ctx(other.ctx), length(other.length) {
+  other.ctx = nullptr;
+}
+EvalContext::ScopeGuard::~ScopeGuard() noexcept { reset(); }
+EvalContext::ScopeGuard &EvalContext::ScopeGuard::operator=(
+    ScopeGuard &&other) noexcept {
+  if (this != &other) {
+    reset();
+    ctx = other.ctx;
+    length = other.length;
+    other.ctx = nullptr;
+  }
+  return *this;
 }
 void EvalContext::ScopeGuard::reset() noexcept {
-  if (f) f();
-  f = function<void()>();
+  if (ctx) ctx->path.resize(length);
+  ctx = nullptr;
 }
 
 EvalException::EvalException(string const &message_) noexcept
@@ -177,13 +419,164 @@ int eval(istream &in, EvalContext &ctx) noexcept {
 
     // generic hyperparams
     Header paramsHeader = Header("Loading settings...");
+    optional<uint64_t> seed = checkMaybeUnsignedInteger(runspec, "seed", ctx);
     EvaluationSettings evaluationSettings = {
         .fightLengthLimit =
             checkMaybeFloat(runspec, "fightLengthLimit", ctx).value_or(360.f),
         .withdrawMultiplier =
             checkMaybeFloat(runspec, "withdrawMultiplier", ctx).value_or(0.1f),
         .debugDump = checkMaybeBool(runspec, "debugDump", ctx).value_or(false),
+        .adaptiveTimeStep =
+            checkMaybeBool(runspec, "adaptiveTimeStep", ctx).value_or(false),
+        .earlyTerminationEpsilon =
+            checkMaybeFloat(runspec, "earlyTerminationEpsilon", ctx)
+                .value_or(0.f),
+        .seed = seed.value_or((random_device())()),
+        .antithetic = false,
+        .replicates =
+            checkMaybeUnsignedInteger(runspec, "replicates", ctx).value_or(1),
+        .antitheticPairs =
+            checkMaybeBool(runspec, "antitheticPairs", ctx).value_or(false),
+        .fireThreads =
+            checkMaybeUnsignedInteger(runspec, "fireThreads", ctx).value_or(0),
+        .isa = detectIsa(),
     };
+    if (optional<string> isa = checkMaybeString(runspec, "isa", ctx);
+        isa && *isa != "auto") {
+      auto _ = ctx.push("isa");
+      optional<Isa> parsed = isaFromString(*isa);
+      if (!parsed)
+        ctx.error(
+            "value must be one of auto, baseline, sse4.2, avx2 or avx512");
+      if (!isaSupported(*parsed))
+        ctx.error("this cpu doesn't support " + *isa);
+      evaluationSettings.isa = *parsed;
+    }
+    if (evaluationSettings.replicates == 0) {
+      auto _ = ctx.push("replicates");
+      ctx.error("value must be at least 1");
+    }
+    vector<ScoringSettings> sweep;
+    if (json const *sweepData = checkMaybeObject(runspec, "sweep", ctx)) {
+      auto _ = ctx.push("sweep");
+      vector<float> fightLengthLimits =
+          checkMaybeFloatArray(*sweepData, "fightLengthLimits", ctx)
+              .value_or(vector{evaluationSettings.fightLengthLimit});
+      vector<float> withdrawMultipliers =
+          checkMaybeFloatArray(*sweepData, "withdrawMultipliers", ctx)
+              .value_or(vector{evaluationSettings.withdrawMultiplier});
+      checkFields(*sweepData, {"fightLengthLimits", "withdrawMultipliers"},
+                  ctx);
+      if (fightLengthLimits.empty() || withdrawMultipliers.empty())
+        ctx.error("fightLengthLimits and withdrawMultipliers can't be empty");
+      for (float fightLengthLimit : fightLengthLimits) {
+        for (float withdrawMultiplier : withdrawMultipliers) {
+          sweep.push_back(ScoringSettings{
+              .fightLengthLimit = fightLengthLimit,
+              .withdrawMultiplier = withdrawMultiplier,
+          });
+        }
+      }
+    }
+    optional<SequentialSettings> sequential;
+    if (json const *sequentialData =
+            checkMaybeObject(runspec, "sequential", ctx)) {
+      auto _ = ctx.push("sequential");
+      sequential = SequentialSettings{
+          .alpha = checkMaybeFloat(*sequentialData, "alpha", ctx)
+                       .value_or(0.05f),
+          .beta =
+              checkMaybeFloat(*sequentialData, "beta", ctx).value_or(0.05f),
+          .winProbability =
+              checkMaybeFloat(*sequentialData, "winProbability", ctx)
+                  .value_or(0.6f),
+          .intervalWidth =
+              checkMaybeFloat(*sequentialData, "intervalWidth", ctx)
+                  .value_or(0.f),
+          .minFights =
+              checkMaybeUnsignedInteger(*sequentialData, "minFights", ctx)
+                  .value_or(2),
+          .maxFights =
+              checkMaybeUnsignedInteger(*sequentialData, "maxFights", ctx)
+                  .value_or(1000),
+      };
+      checkFields(*sequentialData,
+                  {"alpha", "beta", "winProbability", "intervalWidth",
+                   "minFights", "maxFights"},
+                  ctx);
+      if (!(0.f < sequential->alpha && sequential->alpha < 1.f)) {
+        auto _ = ctx.push("alpha");
+        ctx.error("value must be between 0 and 1");
+      }
+      if (!(0.f < sequential->beta && sequential->beta < 1.f)) {
+        auto _ = ctx.push("beta");
+        ctx.error("value must be between 0 and 1");
+      }
+      if (!(0.5f < sequential->winProbability &&
+            sequential->winProbability < 1.f)) {
+        auto _ = ctx.push("winProbability");
+        ctx.error("value must be between 0.5 and 1");
+      }
+      if (sequential->maxFights < max(sequential->minFights, size_t{1})) {
+        auto _ = ctx.push("maxFights");
+        ctx.error("value must be at least 1 and at least minFights");
+      }
+      if (!sweep.empty()) ctx.error("can't be combined with a sweep");
+    }
+    optional<RacingSettings> racing;
+    if (json const *racingData = checkMaybeObject(runspec, "racing", ctx)) {
+      auto _ = ctx.push("racing");
+      racing = RacingSettings{
+          .initialFights =
+              checkMaybeUnsignedInteger(*racingData, "initialFights", ctx)
+                  .value_or(1),
+          .keepFraction = checkMaybeFloat(*racingData, "keepFraction", ctx)
+                              .value_or(0.5f),
+          .fightBudget =
+              checkMaybeUnsignedInteger(*racingData, "fightBudget", ctx)
+                  .value_or(0),
+          .timeBudget =
+              checkMaybeFloat(*racingData, "timeBudget", ctx).value_or(0.f),
+      };
+      checkFields(*racingData,
+                  {"initialFights", "keepFraction", "fightBudget",
+                   "timeBudget"},
+                  ctx);
+      if (racing->initialFights == 0) {
+        auto _ = ctx.push("initialFights");
+        ctx.error("value must be at least 1");
+      }
+      if (!(0.f < racing->keepFraction && racing->keepFraction < 1.f)) {
+        auto _ = ctx.push("keepFraction");
+        ctx.error("value must be between 0 and 1");
+      }
+      if (racing->timeBudget < 0.f) {
+        auto _ = ctx.push("timeBudget");
+        ctx.error("value must be positive");
+      }
+      if (!sweep.empty() || sequential)
+        ctx.error("can't be combined with a sweep or sequential testing");
+    }
+    json const *ratingsData = checkMaybeObject(runspec, "ratings", ctx);
+    optional<string> ratingsFile;
+    optional<size_t> ratingRounds;
+    if (ratingsData) {
+      auto _ = ctx.push("ratings");
+      ratingsFile = checkMaybeString(*ratingsData, "file", ctx);
+      ratingRounds = checkMaybeUnsignedInteger(*ratingsData, "rounds", ctx);
+      checkFields(*ratingsData, {"file", "rounds"}, ctx);
+      if (!sweep.empty() || sequential || racing)
+        ctx.error(
+            "can't be combined with a sweep, sequential testing, or racing");
+    }
+    // results are only reproducible, and so cacheable, with a fixed seed
+    optional<ResultCache> cache;
+    if (optional<string> cacheFile = checkMaybeString(runspec, "cache", ctx)) {
+      auto _ = ctx.push("cache");
+      if (!seed) ctx.error("caching results needs a fixed seed");
+      cache = ResultCache::open(*cacheFile, components, ctx);
+    }
+    ResultCache *cachePtr = cache ? &*cache : nullptr;
     string mode = checkString(runspec, "mode", ctx);
     paramsHeader.finish();
 
@@ -196,49 +589,159 @@ int eval(istream &in, EvalContext &ctx) noexcept {
 
       checkFields(runspec,
                   {"load", "mode", "fightLengthLimit", "withdrawMultiplier",
-                   "debugDump"},
+                   "debugDump", "adaptiveTimeStep",
+                   "earlyTerminationEpsilon", "seed", "replicates",
+                   "antitheticPairs", "fireThreads", "isa", "sweep",
+                   "sequential", "racing", "ratings", "cache"},
                   ctx);
+    } else if (mode == "loadouts") {
+      // loadouts mode - enumerate the best ways to fill each section
+      Header loadoutsHeader = Header("Enumerating section loadouts...");
+      json const *loadoutsData = checkMaybeObject(runspec, "loadouts", ctx);
+      LoadoutSettings loadoutSettings = {
+          .threads = 0,
+          .maxCandidates = 100000,
+          .minTier = 0,
+          .maxTier = numeric_limits<unsigned>::max(),
+      };
+      optional<string> loadoutCache;
+      if (loadoutsData) {
+        auto _ = ctx.push("loadouts");
+        loadoutSettings.threads =
+            checkMaybeUnsignedInteger(*loadoutsData, "threads", ctx)
+                .value_or(0);
+        loadoutSettings.maxCandidates =
+            checkMaybeUnsignedInteger(*loadoutsData, "maxCandidates", ctx)
+                .value_or(loadoutSettings.maxCandidates);
+        loadoutSettings.minTier = static_cast<unsigned>(
+            checkMaybeUnsignedInteger(*loadoutsData, "minTier", ctx)
+                .value_or(loadoutSettings.minTier));
+        loadoutSettings.maxTier = static_cast<unsigned>(
+            checkMaybeUnsignedInteger(*loadoutsData, "maxTier", ctx)
+                .value_or(loadoutSettings.maxTier));
+        loadoutCache = checkMaybeString(*loadoutsData, "cache", ctx);
+        checkFields(*loadoutsData,
+                    {"threads", "maxCandidates", "minTier", "maxTier", "cache"},
+                    ctx);
+      }
+      checkFields(runspec,
+                  {"load", "mode", "fightLengthLimit", "withdrawMultiplier",
+                   "debugDump", "adaptiveTimeStep",
+                   "earlyTerminationEpsilon", "seed", "replicates",
+                   "antitheticPairs", "fireThreads", "isa", "sweep",
+                   "sequential", "racing", "ratings", "cache", "loadouts"},
+                  ctx);
+
+      vector<SectionLoadouts> loadouts =
+          [&components, &loadoutSettings, &loadoutCache, &ctx]() {
+            // loadouts are over every component, not just the ones used
+            components.loadAll();
+            if (!loadoutCache)
+              return enumerateLoadouts(components, loadoutSettings);
+            auto _ = ctx.push("loadouts");
+            return enumerateLoadouts(components, loadoutSettings,
+                                     *loadoutCache, ctx);
+          }();
+      loadoutsHeader.finish();
+
+      cout << "\n"
+           << "Nondominated loadouts\n"
+           << "\n";
+      printLoadouts(loadouts);
     } else if (mode == "manual") {
       // manual mode - read fleets and simulate combat
       Header loadFleetHeader = Header("Loading fleets...");
+      json const *shipsData = checkMaybeArray(runspec, "ships", ctx);
       json const &fleetData = checkArray(runspec, "fleets", ctx);
       checkFields(runspec,
                   {"load", "mode", "fightLengthLimit", "withdrawMultiplier",
-                   "debugDump", "fleets"},
+                   "debugDump", "adaptiveTimeStep",
+                   "earlyTerminationEpsilon", "seed", "replicates",
+                   "antitheticPairs", "fireThreads", "isa", "sweep",
+                   "sequential", "racing", "ratings", "cache", "ships",
+                   "fleets"},
                   ctx);
 
+      // designs shared between fleets are built once
+      ShipRegistry registry = [shipsData, &components, &ctx]() {
+        if (!shipsData) return ShipRegistry();
+        auto _ = ctx.push("ships");
+        return ShipRegistry::fromJson(*shipsData, components, ctx);
+      }();
+
       vector<Fleet> fleets;
+      vector<string> skipped;
       for (auto const &[key, val] : fleetData.items()) {
         auto _ = ctx.push(key);
-        fleets.push_back(Fleet::fromJson(val, components, ctx));
+        Fleet fleet =
+            Fleet::fromJson(val, components, registry, ctx).canonical();
+        // fleets that differ only in order would just fight to a draw
+        auto duplicate = find_if(fleets.begin(), fleets.end(),
+                                 [&fleet](Fleet const &compared) {
+                                   return compared.sameDesign(fleet);
+                                 });
+        if (duplicate != fleets.end())
+          skipped.push_back(fleet.name + " is the same design as " +
+                            duplicate->name + "; skipping");
+        else
+          fleets.push_back(fleet);
       }
       loadFleetHeader.finish();
+      for (string const &message : skipped) cout << message << "\n";
 
       cout << "\n"
-           << "Results\n"
+           << "Results (seed " << evaluationSettings.seed << ")\n"
            << "\n";
-      for (size_t firstIdx = 0; firstIdx < fleets.size(); ++firstIdx) {
-        for (size_t secondIdx = firstIdx + 1; secondIdx < fleets.size();
-             ++secondIdx) {
-          auto const &first = fleets[firstIdx];
-          auto const &second = fleets[secondIdx];
-          cout << first.name << " vs " << second.name << ": ";
-          pair<float, float> result =
-              evaluate(first, second, evaluationSettings);
-          cout << first.name << ": " << -result.first << "/" << first.cost
-               << ", " << second.name << ": " << -result.second << "/"
-               << second.cost;
-          if (result.first < result.second) {
-            cout << "; " << first.name << " wins by "
-                 << result.second - result.first << "\n";
-          } else if (result.second < result.first) {
-            cout << "; " << second.name << " wins by "
-                 << result.first - result.second << "\n";
-          } else {
-            cout << "; draw\n";
+      // every fight in the run shares one pool of fire threads
+      FirePool firePool(evaluationSettings.fireThreads);
+      if (racing) {
+        vector<Fleet const *> pool;
+        for (Fleet const &fleet : fleets) pool.push_back(&fleet);
+        printRanking(fleets, race(pool, pool, evaluationSettings, *racing,
+                                  firePool, cachePtr));
+      } else if (ratingsData) {
+        auto _ = ctx.push("ratings");
+        rate(fleets, ratingsFile, ratingRounds, evaluationSettings, cachePtr,
+             firePool, ctx);
+      } else {
+        for (size_t firstIdx = 0; firstIdx < fleets.size(); ++firstIdx) {
+          for (size_t secondIdx = firstIdx + 1; secondIdx < fleets.size();
+               ++secondIdx) {
+            auto const &first = fleets[firstIdx];
+            auto const &second = fleets[secondIdx];
+            cout << first.name << " vs " << second.name << ": ";
+            if (sequential) {
+              printResult(first, second,
+                          compareSequentially(first, second, evaluationSettings,
+                                              *sequential, firePool,
+                                              cachePtr));
+            } else if (sweep.empty()) {
+              printResult(
+                  first, second,
+                  evaluate(first, second, evaluationSettings, cachePtr,
+                           firePool));
+            } else {
+              cout << "\n";
+              vector<EvaluationResult> results =
+                  evaluate(first, second, evaluationSettings, sweep, firePool);
+              for (size_t idx = 0; idx < sweep.size(); ++idx) {
+                cout << "  fightLengthLimit " << sweep[idx].fightLengthLimit
+                     << ", withdrawMultiplier " << sweep[idx].withdrawMultiplier
+                     << ": ";
+                printResult(first, second, results[idx]);
+              }
+            }
           }
         }
       }
+      if (cache) {
+        cout << "\n"
+             << "Cache: " << cache->hits << " hits, " << cache->misses
+             << " misses\n";
+        if (cache->writeFailures > 0)
+          cerr << "Warning: could not write " << cache->writeFailures
+               << " results to the cache\n";
+      }
     }
   } catch (EvalException const &e) {
     cerr << e.what() << endl;
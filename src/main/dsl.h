@@ -20,29 +20,38 @@
 #ifndef ATHENA2_DSL_H_
 #define ATHENA2_DSL_H_
 
-#include <functional>
+#include <cstddef>
 #include <istream>
 #include <string>
-#include <vector>
+#include <string_view>
 
 namespace athena2 {
+/**
+ * the path to whatever's being checked, like "root > child"; it's kept as one
+ * string that pushes append to and guards cut back, so checking things that
+ * are fine doesn't allocate once the string has grown long enough
+ */
 class EvalContext final {
  public:
   class ScopeGuard final {
    public:
-    explicit ScopeGuard(std::function<void()> const &f) noexcept;
+    ScopeGuard(EvalContext &ctx, std::size_t length) noexcept;
     ScopeGuard(ScopeGuard const &) noexcept = delete;
-    ScopeGuard(ScopeGuard &&) noexcept = default;
+    ScopeGuard(ScopeGuard &&) noexcept;
 
     ~ScopeGuard() noexcept;
 
     ScopeGuard &operator=(ScopeGuard const &) noexcept = delete;
-    ScopeGuard &operator=(ScopeGuard &&) noexcept = default;
+    ScopeGuard &operator=(ScopeGuard &&) noexcept;
 
     void reset() noexcept;
 
    private:
-    std::function<void()> f;
+    EvalContext *ctx;
+    /**
+     * length of the path before the push this guards
+     */
+    std::size_t length;
   };
 
   explicit EvalContext(std::string const &root) noexcept;
@@ -56,10 +65,13 @@ class EvalContext final {
 
   [[noreturn]] void error(std::string const &message);
 
-  ScopeGuard push(std::string const &name) noexcept;
+  /**
+   * appends to the path, which can allocate once it outgrows its buffer
+   */
+  ScopeGuard push(std::string_view name);
 
  private:
-  std::vector<std::string> contextStack;
+  std::string path;
 };
 
 class EvalException final : public std::exception {
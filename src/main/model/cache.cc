@@ -0,0 +1,201 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/cache.h"
+
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+#include <utility>
+
+#include "util/hash.h"
+
+using namespace std;
+using namespace athena2::util;
+using namespace athena2::model::component;
+using namespace athena2::model::design;
+
+namespace athena2::model {
+namespace {
+/**
+ * bump whenever the record layout or the meaning of a key changes
+ */
+constexpr uint64_t CACHE_FORMAT = 1;
+
+/**
+ * bytes in a record: key, first loss, second loss, truncated flag
+ */
+constexpr size_t RECORD_SIZE = sizeof(uint64_t) + 2 * sizeof(float) + 1;
+
+uint64_t contentHash(design::Section const &section,
+                     ComponentSet const &components) noexcept {
+  uint64_t result = components.hashOf(*section.section);
+  result = hashCombine(result, uint64_t{section.weapons.size()});
+  for (component::Weapon const *weapon : section.weapons)
+    result = hashCombine(result, components.hashOf(*weapon));
+  result = hashCombine(result, uint64_t{section.utilities.size()});
+  for (Utility const *utility : section.utilities)
+    result = hashCombine(result, components.hashOf(*utility));
+  result = hashCombine(result, uint64_t{section.auxiliaries.size()});
+  for (Auxiliary const *auxiliary : section.auxiliaries)
+    result = hashCombine(result, components.hashOf(*auxiliary));
+  return result;
+}
+
+uint64_t contentHash(design::Ship const &ship,
+                     ComponentSet const &components) noexcept {
+  uint64_t result = components.hashOf(*ship.hull);
+  result = hashCombine(result, components.hashOf(*ship.reactor));
+  result = hashCombine(result, components.hashOf(*ship.ftl));
+  result = hashCombine(result, components.hashOf(*ship.sublight));
+  result = hashCombine(result, components.hashOf(*ship.sensor));
+  result = hashCombine(result, components.hashOf(*ship.computer));
+  result = hashCombine(
+      result, ship.aura ? components.hashOf(*ship.aura) : uint64_t{0});
+  result = hashCombine(result, uint64_t{ship.sections.size()});
+  for (design::Section const &section : ship.sections)
+    result = hashCombine(result, contentHash(section, components));
+  return result;
+}
+
+}  // namespace
+
+uint64_t settingsHash(EvaluationSettings const &settings, int major,
+                      int minor, int patch) noexcept {
+  uint64_t result = hashCombine(CACHE_FORMAT, settings.fightLengthLimit);
+  result = hashCombine(result, settings.withdrawMultiplier);
+  result = hashCombine(result, settings.earlyTerminationEpsilon);
+  result = hashCombine(result, settings.seed);
+  result = hashCombine(result, uint64_t{settings.antithetic});
+  result = hashCombine(result, uint64_t{settings.replicates});
+  result = hashCombine(result, uint64_t{settings.antitheticPairs});
+  // the simulation may change between versions
+  result = hashCombine(result, static_cast<uint64_t>(major));
+  result = hashCombine(result, static_cast<uint64_t>(minor));
+  result = hashCombine(result, static_cast<uint64_t>(patch));
+  return result;
+}
+
+ResultCache ResultCache::open(string const &filename,
+                              ComponentSet const &components,
+                              EvalContext &ctx) {
+  auto _ = ctx.push(filename);
+
+  // read back every whole record
+  unordered_map<uint64_t, EvaluationResult> index;
+  ifstream in(filename, ios::binary);
+  size_t records = 0;
+  char record[RECORD_SIZE];
+  for (; in.read(record, RECORD_SIZE); ++records) {
+    uint64_t key;
+    float firstLoss;
+    float secondLoss;
+    memcpy(&key, record, sizeof(key));
+    memcpy(&firstLoss, record + sizeof(key), sizeof(firstLoss));
+    memcpy(&secondLoss, record + sizeof(key) + sizeof(firstLoss),
+           sizeof(secondLoss));
+    index.insert_or_assign(key, EvaluationResult{
+                                    .firstLoss = firstLoss,
+                                    .secondLoss = secondLoss,
+                                    .truncated = record[RECORD_SIZE - 1] != 0,
+                                });
+  }
+
+  // cut off a partial record, so new records start on a record boundary
+  if (in.gcount() > 0) {
+    in.close();
+    error_code error;
+    filesystem::resize_file(filename, records * RECORD_SIZE, error);
+    if (error) ctx.error("could not cut off partial record");
+  }
+
+  ofstream log(filename, ios::binary | ios::app);
+  if (!log) ctx.error("could not open file");
+  return ResultCache(components, move(index), move(log));
+}
+
+ResultCache::ResultCache(ComponentSet const &components_,
+                         unordered_map<uint64_t, EvaluationResult> &&index_,
+                         ofstream &&log_) noexcept
+    : hits(0),
+      misses(0),
+      writeFailures(0),
+      components(&components_),
+      index(move(index_)),
+      log(move(log_)) {}
+
+EvaluationResult ResultCache::evaluate(
+    design::Fleet const &a, design::Fleet const &b,
+    EvaluationSettings const &settings) noexcept {
+  FirePool pool(settings.fireThreads);
+  return evaluate(a, b, settings, pool);
+}
+
+EvaluationResult ResultCache::evaluate(design::Fleet const &a,
+                                       design::Fleet const &b,
+                                       EvaluationSettings const &settings,
+                                       FirePool &pool) noexcept {
+  uint64_t key = this->key(a, b, settings);
+  auto found = index.find(key);
+  if (found != index.end()) {
+    ++hits;
+    return found->second;
+  }
+
+  ++misses;
+  EvaluationResult result = model::evaluate(a, b, settings, pool);
+  index.emplace(key, result);
+
+  char record[RECORD_SIZE];
+  memcpy(record, &key, sizeof(key));
+  memcpy(record + sizeof(key), &result.firstLoss, sizeof(result.firstLoss));
+  memcpy(record + sizeof(key) + sizeof(result.firstLoss), &result.secondLoss,
+         sizeof(result.secondLoss));
+  record[RECORD_SIZE - 1] = result.truncated ? 1 : 0;
+  // a failed write may leave a partial record, so stop writing after one
+  if (log) {
+    log.write(record, RECORD_SIZE);
+    log.flush();
+  }
+  if (!log) ++writeFailures;
+  return result;
+}
+
+uint64_t ResultCache::key(design::Fleet const &a, design::Fleet const &b,
+                          EvaluationSettings const &settings) const noexcept {
+  return hashCombine(hashCombine(settingsHash(settings), fleetHash(a)),
+                     fleetHash(b));
+}
+
+uint64_t ResultCache::fleetHash(design::Fleet const &fleet) const noexcept {
+  uint64_t result = fleet.ships.size();
+  for (auto const &[ship, count] : fleet.ships) {
+    result = hashCombine(result, contentHash(*ship, *components));
+    result = hashCombine(result, uint64_t{count});
+  }
+  return result;
+}
+
+EvaluationResult evaluate(design::Fleet const &a, design::Fleet const &b,
+                          EvaluationSettings const &settings,
+                          ResultCache *cache, FirePool &pool) noexcept {
+  return cache ? cache->evaluate(a, b, settings, pool)
+               : evaluate(a, b, settings, pool);
+}
+}  // namespace athena2::model
@@ -0,0 +1,117 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ATHENA2_MODEL_CACHE_H_
+#define ATHENA2_MODEL_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+#include "dsl.h"
+#include "model/component/componentSet.h"
+#include "model/design/fleet.h"
+#include "model/evaluator.h"
+#include "model/firePool.h"
+#include "version.h"
+
+namespace athena2::model {
+/**
+ * hash of the settings that affect a result, under the given version of the
+ * simulation
+ *
+ * debugDump, adaptiveTimeStep, fireThreads, and isa are left out, since they
+ * don't change the result
+ */
+std::uint64_t settingsHash(EvaluationSettings const &settings,
+                           int major = ATHENA2_VERSION_MAJOR,
+                           int minor = ATHENA2_VERSION_MINOR,
+                           int patch = ATHENA2_VERSION_PATCH) noexcept;
+/**
+ * on-disk cache of evaluation results
+ *
+ * results are keyed by a hash of the contents of every component in both
+ * fleets, the fleets' ship counts, and every setting that affects the result,
+ * including the seed; changing a component's data only misses entries for
+ * fleets that use it. Names don't affect the key
+ *
+ * the file is an append-only log of fixed-size records, indexed in memory
+ * when opened; later records for a key win. A partial record left at the end
+ * by an interrupted write is cut off when the file is opened, and once a
+ * write fails, nothing more is written to the file
+ */
+class ResultCache final {
+ public:
+  static ResultCache open(std::string const &filename,
+                          component::ComponentSet const &components,
+                          EvalContext &ctx);
+
+  ResultCache(ResultCache const &) = delete;
+  ResultCache(ResultCache &&) noexcept = default;
+
+  ~ResultCache() noexcept = default;
+
+  ResultCache &operator=(ResultCache const &) = delete;
+  ResultCache &operator=(ResultCache &&) noexcept = default;
+
+  /**
+   * the cached result for these fleets and settings, evaluating and
+   * recording it if there is none
+   */
+  EvaluationResult evaluate(design::Fleet const &a, design::Fleet const &b,
+                            EvaluationSettings const &settings) noexcept;
+  EvaluationResult evaluate(design::Fleet const &a, design::Fleet const &b,
+                            EvaluationSettings const &settings,
+                            FirePool &pool) noexcept;
+
+  /**
+   * the key the result for these fleets and settings is cached under
+   */
+  std::uint64_t key(design::Fleet const &a, design::Fleet const &b,
+                    EvaluationSettings const &settings) const noexcept;
+
+  std::size_t hits;
+  std::size_t misses;
+  /**
+   * results that couldn't be written to the file
+   */
+  std::size_t writeFailures;
+
+ private:
+  ResultCache(component::ComponentSet const &components,
+              std::unordered_map<std::uint64_t, EvaluationResult> &&index,
+              std::ofstream &&log) noexcept;
+
+  std::uint64_t fleetHash(design::Fleet const &) const noexcept;
+
+  component::ComponentSet const *components;
+  std::unordered_map<std::uint64_t, EvaluationResult> index;
+  std::ofstream log;
+};
+/**
+ * evaluate on the given pool, through the cache if there is one
+ */
+EvaluationResult evaluate(design::Fleet const &a, design::Fleet const &b,
+                          EvaluationSettings const &settings,
+                          ResultCache *cache, FirePool &pool) noexcept;
+}  // namespace athena2::model
+
+#endif  // ATHENA2_MODEL_CACHE_H_
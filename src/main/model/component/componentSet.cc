@@ -19,22 +19,139 @@
 
 #include "model/component/componentSet.h"
 
+#include <algorithm>
 #include <string>
 #include <utility>
 
+#include "util/hash.h"
+
 using namespace std;
+using namespace athena2::util;
 
 namespace athena2::model::component {
 namespace {
-template <typename T>
-void addChecked(vector<T> &destination, T &&component, EvalContext &ctx) {
-  if (find_if(destination.begin(), destination.end(),
-              [&component](T const &compared) {
-                return compared.name == component.name;
-              }) != destination.end())
-    ctx.error("duplicate component " + component.name);
+/**
+ * place of a component that's been deferred but not loaded
+ */
+constexpr ComponentId UNLOADED = 0xffff;
 
+/**
+ * move any of a component's data that its index keeps into the index
+ */
+template <typename T, typename Index>
+void attach(vector<T> const &, Index &, T &, ComponentId) noexcept {}
+template <typename Index>
+void attach(vector<Weapon> const &, Index &index, Weapon &weapon,
+            ComponentId id) noexcept {
+  weapon.moveStatsTo(index.stats[id]);
+}
+/**
+ * make sure there's room for at least size components, growing geometrically
+ * so a run of adds doesn't move every component each time
+ */
+template <typename T, typename Index>
+void makeRoom(vector<T> &destination, Index &, size_t size) {
+  if (size > destination.capacity())
+    destination.reserve(max(size, 2 * destination.capacity()));
+}
+/**
+ * as makeRoom, also growing the stats table to match, so loading a deferred
+ * weapon never moves the stats already handed out
+ */
+template <typename Index>
+void makeRoom(vector<Weapon> &destination, Index &index, size_t size) {
+  if (size <= index.stats.capacity()) return;
+  size = max(size, 2 * index.stats.capacity());
+  destination.reserve(size);
+  index.stats.reserve(size);
+  // the weapons already in the set point into the table's old storage
+  for (size_t place = 0; place < destination.size(); ++place)
+    destination[place].stats = &index.stats[index.ids[place]];
+}
+/**
+ * give out the next id, before the component it's for is loaded
+ */
+template <typename T, typename Index>
+ComponentId reserve(vector<T> const &, Index &index) {
+  auto id = static_cast<ComponentId>(index.places.size());
+  index.places.push_back(UNLOADED);
+  return id;
+}
+template <typename Index>
+ComponentId reserve(vector<Weapon> const &, Index &index) {
+  auto id = static_cast<ComponentId>(index.places.size());
+  index.places.push_back(UNLOADED);
+  index.stats.emplace_back();
+  return id;
+}
+template <typename T, typename Index>
+void insert(vector<T> &destination, Index &index, T &&component, uint64_t hash,
+            unsigned tier, ComponentId id) {
+  auto place = static_cast<ComponentId>(destination.size());
   destination.emplace_back(move(component));
+  attach(destination, index, destination.back(), id);
+  index.hashes.push_back(hash);
+  index.tiers.push_back(tier);
+  index.ids.push_back(id);
+  index.places[id] = place;
+  index.byTier.insert(
+      upper_bound(index.byTier.begin(), index.byTier.end(), pair(tier, id),
+                  [&index](pair<unsigned, ComponentId> value,
+                           ComponentId other) {
+                    return value < pair(index.tiers[other], index.ids[other]);
+                  }),
+      place);
+}
+template <typename T, typename Pending>
+void checkNew(vector<T> const &destination, vector<Pending> const &pending,
+              string const &name, EvalContext &ctx) {
+  if (find_if(destination.begin(), destination.end(),
+              [&name](T const &compared) { return compared.name == name; }) !=
+          destination.end() ||
+      find_if(pending.begin(), pending.end(),
+              [&name](Pending const &compared) {
+                return compared.name == name;
+              }) != pending.end())
+    ctx.error("duplicate component " + name);
+  if (destination.size() + pending.size() == ComponentSet::MAX_COMPONENTS)
+    ctx.error("too many components of the same type");
+}
+template <typename T, typename Index, typename Pending>
+void addChecked(vector<T> &destination, Index &index,
+                vector<Pending> const &pending, T &&component, uint64_t hash,
+                unsigned tier, EvalContext &ctx) {
+  checkNew(destination, pending, component.name, ctx);
+  makeRoom(destination, index, index.places.size() + 1);
+  ComponentId id = reserve(destination, index);
+  insert(destination, index, move(component), hash, tier, id);
+}
+template <typename T, typename Index, typename Pending, typename Loader>
+void deferChecked(vector<T> &destination, Index &index,
+                  vector<Pending> &pending, string const &name, Loader &&load,
+                  unsigned tier, EvalContext &ctx) {
+  checkNew(destination, pending, name, ctx);
+  makeRoom(destination, index, index.places.size() + 1);
+  pending.push_back({.name = name,
+                     .load = move(load),
+                     .tier = tier,
+                     .id = reserve(destination, index)});
+}
+template <typename T, typename Index, typename Pending>
+T const *loadFrom(vector<T> &destination, Index &index,
+                  vector<Pending> &pending,
+                  typename vector<Pending>::iterator it) {
+  auto [component, hash] = it->load();
+  unsigned tier = it->tier;
+  ComponentId id = it->id;
+  pending.erase(it);
+  insert(destination, index, move(component), hash, tier, id);
+  return &destination.back();
+}
+template <typename T, typename Index, typename Pending>
+void loadAllFrom(vector<T> &destination, Index &index,
+                 vector<Pending> &pending) {
+  while (!pending.empty())
+    loadFrom(destination, index, pending, pending.begin());
 }
 template <typename T>
 T const *getFrom(vector<T> const &from, string const &name) {
@@ -46,83 +163,385 @@ T const *getFrom(vector<T> const &from, string const &name) {
   else
     return &*it;
 }
+template <typename T, typename Index, typename Pending>
+T const *getFrom(vector<T> &from, Index &index, vector<Pending> &pending,
+                 string const &name) {
+  if (T const *loaded = getFrom(from, name); loaded) return loaded;
+  auto it = find_if(pending.begin(), pending.end(),
+                    [&name](Pending const &component) {
+                      return component.name == name;
+                    });
+  if (it == pending.end()) return nullptr;
+  return loadFrom(from, index, pending, it);
+}
+template <typename T, typename Index>
+T const *getFrom(vector<T> const &from, Index const &index, ComponentId id) {
+  return id < index.places.size() && index.places[id] != UNLOADED
+             ? &from[index.places[id]]
+             : nullptr;
+}
+template <typename T, typename Index>
+ComponentId idFrom(vector<T> const &from, Index const &index,
+                   T const &component) {
+  return index.ids[static_cast<size_t>(&component - from.data())];
+}
+template <typename T, typename Index>
+uint64_t hashFrom(vector<T> const &from, Index const &index,
+                  T const &component) {
+  return index.hashes[static_cast<size_t>(&component - from.data())];
+}
+template <typename Index>
+uint64_t fingerprintOf(uint64_t result, Index const &index) {
+  result = hashCombine(result, uint64_t{index.hashes.size()});
+  for (ComponentId place : index.places) {
+    if (place == UNLOADED) continue;
+    result = hashCombine(result, index.hashes[place]);
+    result = hashCombine(result, uint64_t{index.tiers[place]});
+  }
+  return result;
+}
 }  // namespace
 
-ComponentSet &ComponentSet::add(Hull &&hull, EvalContext &ctx) {
-  addChecked(hulls, move(hull), ctx);
+ComponentSet &ComponentSet::add(Hull &&hull, EvalContext &ctx,
+                                uint64_t hash, unsigned tier) {
+  addChecked(hulls, hullIndex, pendingHulls, move(hull), hash, tier, ctx);
+  return *this;
+}
+ComponentSet &ComponentSet::add(Section &&section, EvalContext &ctx,
+                                uint64_t hash, unsigned tier) {
+  addChecked(sections, sectionIndex, pendingSections, move(section), hash,
+             tier, ctx);
+  return *this;
+}
+ComponentSet &ComponentSet::add(Reactor &&reactor, EvalContext &ctx,
+                                uint64_t hash, unsigned tier) {
+  addChecked(reactors, reactorIndex, pendingReactors, move(reactor), hash,
+             tier, ctx);
+  return *this;
+}
+ComponentSet &ComponentSet::add(FTL &&ftl, EvalContext &ctx,
+                                uint64_t hash, unsigned tier) {
+  addChecked(ftls, ftlIndex, pendingFTLs, move(ftl), hash, tier, ctx);
+  return *this;
+}
+ComponentSet &ComponentSet::add(Sublight &&sublight, EvalContext &ctx,
+                                uint64_t hash, unsigned tier) {
+  addChecked(sublights, sublightIndex, pendingSublights, move(sublight), hash,
+             tier, ctx);
+  return *this;
+}
+ComponentSet &ComponentSet::add(Sensor &&sensor, EvalContext &ctx,
+                                uint64_t hash, unsigned tier) {
+  addChecked(sensors, sensorIndex, pendingSensors, move(sensor), hash, tier,
+             ctx);
+  return *this;
+}
+ComponentSet &ComponentSet::add(Computer &&computer, EvalContext &ctx,
+                                uint64_t hash, unsigned tier) {
+  addChecked(computers, computerIndex, pendingComputers, move(computer), hash,
+             tier, ctx);
+  return *this;
+}
+ComponentSet &ComponentSet::add(Aura &&aura, EvalContext &ctx,
+                                uint64_t hash, unsigned tier) {
+  addChecked(auras, auraIndex, pendingAuras, move(aura), hash, tier, ctx);
   return *this;
 }
-ComponentSet &ComponentSet::add(Section &&section, EvalContext &ctx) {
-  addChecked(sections, move(section), ctx);
+ComponentSet &ComponentSet::add(Utility &&utility, EvalContext &ctx,
+                                uint64_t hash, unsigned tier) {
+  addChecked(utilities, utilityIndex, pendingUtilities, move(utility), hash,
+             tier, ctx);
   return *this;
 }
-ComponentSet &ComponentSet::add(Reactor &&reactor, EvalContext &ctx) {
-  addChecked(reactors, move(reactor), ctx);
+ComponentSet &ComponentSet::add(Auxiliary &&auxiliary, EvalContext &ctx,
+                                uint64_t hash, unsigned tier) {
+  addChecked(auxiliaries, auxiliaryIndex, pendingAuxiliaries, move(auxiliary),
+             hash, tier, ctx);
   return *this;
 }
-ComponentSet &ComponentSet::add(FTL &&ftl, EvalContext &ctx) {
-  addChecked(ftls, move(ftl), ctx);
+ComponentSet &ComponentSet::add(Weapon &&weapon, EvalContext &ctx,
+                                uint64_t hash, unsigned tier) {
+  addChecked(weapons, weaponIndex, pendingWeapons, move(weapon), hash, tier,
+             ctx);
   return *this;
 }
-ComponentSet &ComponentSet::add(Sublight &&sublight, EvalContext &ctx) {
-  addChecked(sublights, move(sublight), ctx);
+ComponentSet &ComponentSet::defer(string const &name, Loader<Hull> &&load,
+                                  EvalContext &ctx, unsigned tier) {
+  deferChecked(hulls, hullIndex, pendingHulls, name, move(load), tier, ctx);
   return *this;
 }
-ComponentSet &ComponentSet::add(Sensor &&sensor, EvalContext &ctx) {
-  addChecked(sensors, move(sensor), ctx);
+ComponentSet &ComponentSet::defer(string const &name, Loader<Section> &&load,
+                                  EvalContext &ctx, unsigned tier) {
+  deferChecked(sections, sectionIndex, pendingSections, name, move(load), tier,
+               ctx);
   return *this;
 }
-ComponentSet &ComponentSet::add(Computer &&computer, EvalContext &ctx) {
-  addChecked(computers, move(computer), ctx);
+ComponentSet &ComponentSet::defer(string const &name, Loader<Reactor> &&load,
+                                  EvalContext &ctx, unsigned tier) {
+  deferChecked(reactors, reactorIndex, pendingReactors, name, move(load), tier,
+               ctx);
   return *this;
 }
-ComponentSet &ComponentSet::add(Aura &&aura, EvalContext &ctx) {
-  addChecked(auras, move(aura), ctx);
+ComponentSet &ComponentSet::defer(string const &name, Loader<FTL> &&load,
+                                  EvalContext &ctx, unsigned tier) {
+  deferChecked(ftls, ftlIndex, pendingFTLs, name, move(load), tier, ctx);
   return *this;
 }
-ComponentSet &ComponentSet::add(Utility &&utility, EvalContext &ctx) {
-  addChecked(utilities, move(utility), ctx);
+ComponentSet &ComponentSet::defer(string const &name, Loader<Sublight> &&load,
+                                  EvalContext &ctx, unsigned tier) {
+  deferChecked(sublights, sublightIndex, pendingSublights, name, move(load),
+               tier, ctx);
   return *this;
 }
-ComponentSet &ComponentSet::add(Auxiliary &&auxiliary, EvalContext &ctx) {
-  addChecked(auxiliaries, move(auxiliary), ctx);
+ComponentSet &ComponentSet::defer(string const &name, Loader<Sensor> &&load,
+                                  EvalContext &ctx, unsigned tier) {
+  deferChecked(sensors, sensorIndex, pendingSensors, name, move(load), tier,
+               ctx);
   return *this;
 }
-ComponentSet &ComponentSet::add(Weapon &&weapon, EvalContext &ctx) {
-  addChecked(weapons, move(weapon), ctx);
+ComponentSet &ComponentSet::defer(string const &name, Loader<Computer> &&load,
+                                  EvalContext &ctx, unsigned tier) {
+  deferChecked(computers, computerIndex, pendingComputers, name, move(load),
+               tier, ctx);
   return *this;
 }
-Hull const *ComponentSet::getHull(string const &name) const noexcept {
-  return getFrom(hulls, name);
+ComponentSet &ComponentSet::defer(string const &name, Loader<Aura> &&load,
+                                  EvalContext &ctx, unsigned tier) {
+  deferChecked(auras, auraIndex, pendingAuras, name, move(load), tier, ctx);
+  return *this;
+}
+ComponentSet &ComponentSet::defer(string const &name, Loader<Utility> &&load,
+                                  EvalContext &ctx, unsigned tier) {
+  deferChecked(utilities, utilityIndex, pendingUtilities, name, move(load),
+               tier, ctx);
+  return *this;
+}
+ComponentSet &ComponentSet::defer(string const &name, Loader<Auxiliary> &&load,
+                                  EvalContext &ctx, unsigned tier) {
+  deferChecked(auxiliaries, auxiliaryIndex, pendingAuxiliaries, name,
+               move(load), tier, ctx);
+  return *this;
+}
+ComponentSet &ComponentSet::defer(string const &name, Loader<Weapon> &&load,
+                                  EvalContext &ctx, unsigned tier) {
+  deferChecked(weapons, weaponIndex, pendingWeapons, name, move(load), tier,
+               ctx);
+  return *this;
+}
+void ComponentSet::loadAll() const {
+  loadAllFrom(hulls, hullIndex, pendingHulls);
+  loadAllFrom(sections, sectionIndex, pendingSections);
+  loadAllFrom(reactors, reactorIndex, pendingReactors);
+  loadAllFrom(ftls, ftlIndex, pendingFTLs);
+  loadAllFrom(sublights, sublightIndex, pendingSublights);
+  loadAllFrom(sensors, sensorIndex, pendingSensors);
+  loadAllFrom(computers, computerIndex, pendingComputers);
+  loadAllFrom(auras, auraIndex, pendingAuras);
+  loadAllFrom(utilities, utilityIndex, pendingUtilities);
+  loadAllFrom(auxiliaries, auxiliaryIndex, pendingAuxiliaries);
+  loadAllFrom(weapons, weaponIndex, pendingWeapons);
+}
+Hull const *ComponentSet::getHull(string const &name) const {
+  return getFrom(hulls, hullIndex, pendingHulls, name);
+}
+Section const *ComponentSet::getSection(string const &name) const {
+  return getFrom(sections, sectionIndex, pendingSections, name);
+}
+Reactor const *ComponentSet::getReactor(string const &name) const {
+  return getFrom(reactors, reactorIndex, pendingReactors, name);
+}
+FTL const *ComponentSet::getFTL(string const &name) const {
+  return getFrom(ftls, ftlIndex, pendingFTLs, name);
+}
+Sublight const *ComponentSet::getSublight(string const &name) const {
+  return getFrom(sublights, sublightIndex, pendingSublights, name);
+}
+Sensor const *ComponentSet::getSensor(string const &name) const {
+  return getFrom(sensors, sensorIndex, pendingSensors, name);
+}
+Computer const *ComponentSet::getComputer(string const &name) const {
+  return getFrom(computers, computerIndex, pendingComputers, name);
+}
+Aura const *ComponentSet::getAura(string const &name) const {
+  return getFrom(auras, auraIndex, pendingAuras, name);
+}
+Utility const *ComponentSet::getUtility(string const &name) const {
+  return getFrom(utilities, utilityIndex, pendingUtilities, name);
+}
+Auxiliary const *ComponentSet::getAuxiliary(string const &name) const {
+  return getFrom(auxiliaries, auxiliaryIndex, pendingAuxiliaries, name);
+}
+Weapon const *ComponentSet::getWeapon(string const &name) const {
+  return getFrom(weapons, weaponIndex, pendingWeapons, name);
+}
+Hull const *ComponentSet::getHull(ComponentId id) const noexcept {
+  return getFrom(hulls, hullIndex, id);
+}
+Section const *ComponentSet::getSection(ComponentId id) const noexcept {
+  return getFrom(sections, sectionIndex, id);
+}
+Reactor const *ComponentSet::getReactor(ComponentId id) const noexcept {
+  return getFrom(reactors, reactorIndex, id);
+}
+FTL const *ComponentSet::getFTL(ComponentId id) const noexcept {
+  return getFrom(ftls, ftlIndex, id);
+}
+Sublight const *ComponentSet::getSublight(ComponentId id) const noexcept {
+  return getFrom(sublights, sublightIndex, id);
+}
+Sensor const *ComponentSet::getSensor(ComponentId id) const noexcept {
+  return getFrom(sensors, sensorIndex, id);
+}
+Computer const *ComponentSet::getComputer(ComponentId id) const noexcept {
+  return getFrom(computers, computerIndex, id);
+}
+Aura const *ComponentSet::getAura(ComponentId id) const noexcept {
+  return getFrom(auras, auraIndex, id);
+}
+Utility const *ComponentSet::getUtility(ComponentId id) const noexcept {
+  return getFrom(utilities, utilityIndex, id);
+}
+Auxiliary const *ComponentSet::getAuxiliary(ComponentId id) const noexcept {
+  return getFrom(auxiliaries, auxiliaryIndex, id);
+}
+Weapon const *ComponentSet::getWeapon(ComponentId id) const noexcept {
+  return getFrom(weapons, weaponIndex, id);
+}
+Weapon::Stats const *ComponentSet::getWeaponStats(
+    ComponentId id) const noexcept {
+  return getWeapon(id) ? &weaponIndex.stats[id] : nullptr;
+}
+ComponentId ComponentSet::idOf(Hull const &component) const noexcept {
+  return idFrom(hulls, hullIndex, component);
+}
+ComponentId ComponentSet::idOf(Section const &component) const noexcept {
+  return idFrom(sections, sectionIndex, component);
+}
+ComponentId ComponentSet::idOf(Reactor const &component) const noexcept {
+  return idFrom(reactors, reactorIndex, component);
+}
+ComponentId ComponentSet::idOf(FTL const &component) const noexcept {
+  return idFrom(ftls, ftlIndex, component);
+}
+ComponentId ComponentSet::idOf(Sublight const &component) const noexcept {
+  return idFrom(sublights, sublightIndex, component);
+}
+ComponentId ComponentSet::idOf(Sensor const &component) const noexcept {
+  return idFrom(sensors, sensorIndex, component);
+}
+ComponentId ComponentSet::idOf(Computer const &component) const noexcept {
+  return idFrom(computers, computerIndex, component);
+}
+ComponentId ComponentSet::idOf(Aura const &component) const noexcept {
+  return idFrom(auras, auraIndex, component);
+}
+ComponentId ComponentSet::idOf(Utility const &component) const noexcept {
+  return idFrom(utilities, utilityIndex, component);
+}
+ComponentId ComponentSet::idOf(Auxiliary const &component) const noexcept {
+  return idFrom(auxiliaries, auxiliaryIndex, component);
+}
+ComponentId ComponentSet::idOf(Weapon const &component) const noexcept {
+  return idFrom(weapons, weaponIndex, component);
+}
+uint64_t ComponentSet::fingerprint() const noexcept {
+  uint64_t result = 0;
+  result = fingerprintOf(result, hullIndex);
+  result = fingerprintOf(result, sectionIndex);
+  result = fingerprintOf(result, reactorIndex);
+  result = fingerprintOf(result, ftlIndex);
+  result = fingerprintOf(result, sublightIndex);
+  result = fingerprintOf(result, sensorIndex);
+  result = fingerprintOf(result, computerIndex);
+  result = fingerprintOf(result, auraIndex);
+  result = fingerprintOf(result, utilityIndex);
+  result = fingerprintOf(result, auxiliaryIndex);
+  result = fingerprintOf(result, weaponIndex);
+  return result;
+}
+ComponentView<Hull> ComponentSet::hullView(
+    ComponentFilter const &filter) const noexcept {
+  return ComponentView<Hull>(hulls, hullIndex.tiers, hullIndex.byTier, filter);
+}
+ComponentView<Section> ComponentSet::sectionView(
+    ComponentFilter const &filter) const noexcept {
+  return ComponentView<Section>(sections, sectionIndex.tiers,
+                                sectionIndex.byTier, filter);
+}
+ComponentView<Reactor> ComponentSet::reactorView(
+    ComponentFilter const &filter) const noexcept {
+  return ComponentView<Reactor>(reactors, reactorIndex.tiers,
+                                reactorIndex.byTier, filter);
+}
+ComponentView<FTL> ComponentSet::ftlView(
+    ComponentFilter const &filter) const noexcept {
+  return ComponentView<FTL>(ftls, ftlIndex.tiers, ftlIndex.byTier, filter);
+}
+ComponentView<Sublight> ComponentSet::sublightView(
+    ComponentFilter const &filter) const noexcept {
+  return ComponentView<Sublight>(sublights, sublightIndex.tiers,
+                                 sublightIndex.byTier, filter);
+}
+ComponentView<Sensor> ComponentSet::sensorView(
+    ComponentFilter const &filter) const noexcept {
+  return ComponentView<Sensor>(sensors, sensorIndex.tiers,
+                               sensorIndex.byTier, filter);
+}
+ComponentView<Computer> ComponentSet::computerView(
+    ComponentFilter const &filter) const noexcept {
+  return ComponentView<Computer>(computers, computerIndex.tiers,
+                                 computerIndex.byTier, filter);
+}
+ComponentView<Aura> ComponentSet::auraView(
+    ComponentFilter const &filter) const noexcept {
+  return ComponentView<Aura>(auras, auraIndex.tiers, auraIndex.byTier, filter);
+}
+ComponentView<Utility> ComponentSet::utilityView(
+    ComponentFilter const &filter) const noexcept {
+  return ComponentView<Utility>(utilities, utilityIndex.tiers,
+                                utilityIndex.byTier, filter);
+}
+ComponentView<Auxiliary> ComponentSet::auxiliaryView(
+    ComponentFilter const &filter) const noexcept {
+  return ComponentView<Auxiliary>(auxiliaries, auxiliaryIndex.tiers,
+                                  auxiliaryIndex.byTier, filter);
+}
+ComponentView<Weapon> ComponentSet::weaponView(
+    ComponentFilter const &filter) const noexcept {
+  return ComponentView<Weapon>(weapons, weaponIndex.tiers,
+                               weaponIndex.byTier, filter);
+}
+uint64_t ComponentSet::hashOf(Hull const &component) const noexcept {
+  return hashFrom(hulls, hullIndex, component);
 }
-Section const *ComponentSet::getSection(string const &name) const noexcept {
-  return getFrom(sections, name);
+uint64_t ComponentSet::hashOf(Section const &component) const noexcept {
+  return hashFrom(sections, sectionIndex, component);
 }
-Reactor const *ComponentSet::getReactor(string const &name) const noexcept {
-  return getFrom(reactors, name);
+uint64_t ComponentSet::hashOf(Reactor const &component) const noexcept {
+  return hashFrom(reactors, reactorIndex, component);
 }
-FTL const *ComponentSet::getFTL(string const &name) const noexcept {
-  return getFrom(ftls, name);
+uint64_t ComponentSet::hashOf(FTL const &component) const noexcept {
+  return hashFrom(ftls, ftlIndex, component);
 }
-Sublight const *ComponentSet::getSublight(string const &name) const noexcept {
-  return getFrom(sublights, name);
+uint64_t ComponentSet::hashOf(Sublight const &component) const noexcept {
+  return hashFrom(sublights, sublightIndex, component);
 }
-Sensor const *ComponentSet::getSensor(string const &name) const noexcept {
-  return getFrom(sensors, name);
+uint64_t ComponentSet::hashOf(Sensor const &component) const noexcept {
+  return hashFrom(sensors, sensorIndex, component);
 }
-Computer const *ComponentSet::getComputer(string const &name) const noexcept {
-  return getFrom(computers, name);
+uint64_t ComponentSet::hashOf(Computer const &component) const noexcept {
+  return hashFrom(computers, computerIndex, component);
 }
-Aura const *ComponentSet::getAura(string const &name) const noexcept {
-  return getFrom(auras, name);
+uint64_t ComponentSet::hashOf(Aura const &component) const noexcept {
+  return hashFrom(auras, auraIndex, component);
 }
-Utility const *ComponentSet::getUtility(string const &name) const noexcept {
-  return getFrom(utilities, name);
+uint64_t ComponentSet::hashOf(Utility const &component) const noexcept {
+  return hashFrom(utilities, utilityIndex, component);
 }
-Auxiliary const *ComponentSet::getAuxiliary(string const &name) const noexcept {
-  return getFrom(auxiliaries, name);
+uint64_t ComponentSet::hashOf(Auxiliary const &component) const noexcept {
+  return hashFrom(auxiliaries, auxiliaryIndex, component);
 }
-Weapon const *ComponentSet::getWeapon(string const &name) const noexcept {
-  return getFrom(weapons, name);
+uint64_t ComponentSet::hashOf(Weapon const &component) const noexcept {
+  return hashFrom(weapons, weaponIndex, component);
 }
 }  // namespace athena2::model::component
@@ -20,6 +20,9 @@
 #ifndef ATHENA2_MODEL_COMPONENT_COMPONENTSET_H_
 #define ATHENA2_MODEL_COMPONENT_COMPONENTSET_H_
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <optional>
 #include <string>
 #include <utility>
@@ -28,6 +31,7 @@
 #include "dsl.h"
 #include "model/component/aura.h"
 #include "model/component/auxiliary.h"
+#include "model/component/componentView.h"
 #include "model/component/computer.h"
 #include "model/component/ftl.h"
 #include "model/component/hull.h"
@@ -50,42 +54,263 @@ class ComponentSet final {
   ComponentSet &operator=(ComponentSet const &) = delete;
   ComponentSet &operator=(ComponentSet &&) = default;
 
-  ComponentSet &add(Hull &&, EvalContext &);
-  ComponentSet &add(Section &&, EvalContext &);
-  ComponentSet &add(Reactor &&, EvalContext &);
-  ComponentSet &add(FTL &&, EvalContext &);
-  ComponentSet &add(Sublight &&, EvalContext &);
-  ComponentSet &add(Sensor &&, EvalContext &);
-  ComponentSet &add(Computer &&, EvalContext &);
-  ComponentSet &add(Aura &&, EvalContext &);
-  ComponentSet &add(Utility &&, EvalContext &);
-  ComponentSet &add(Auxiliary &&, EvalContext &);
-  ComponentSet &add(Weapon &&, EvalContext &);
-
-  Hull const *getHull(std::string const &name) const noexcept;
-  Section const *getSection(std::string const &name) const noexcept;
-  Reactor const *getReactor(std::string const &name) const noexcept;
-  FTL const *getFTL(std::string const &name) const noexcept;
-  Sublight const *getSublight(std::string const &name) const noexcept;
-  Sensor const *getSensor(std::string const &name) const noexcept;
-  Computer const *getComputer(std::string const &name) const noexcept;
-  Aura const *getAura(std::string const &name) const noexcept;
-  Utility const *getUtility(std::string const &name) const noexcept;
-  Auxiliary const *getAuxiliary(std::string const &name) const noexcept;
-  Weapon const *getWeapon(std::string const &name) const noexcept;
+  /**
+   * ids stay below this, so their top bit is free for tagging and all ones is
+   * never an id
+   */
+  static constexpr std::size_t MAX_COMPONENTS = 0x7fff;
+
+  /**
+   * parses and validates a deferred component, returning it and the hash of
+   * the data it was loaded from
+   *
+   * @throws EvalException if the component is invalid
+   */
+  template <typename T>
+  using Loader = std::function<std::pair<T, std::uint64_t>()>;
+
+  /**
+   * adds a loaded component, with the hash of the data it was loaded from;
+   * cached results tell components apart by that hash, so it can't be left
+   * out
+   */
+  ComponentSet &add(Hull &&, EvalContext &, std::uint64_t hash,
+                    unsigned tier = 0);
+  ComponentSet &add(Section &&, EvalContext &, std::uint64_t hash,
+                    unsigned tier = 0);
+  ComponentSet &add(Reactor &&, EvalContext &, std::uint64_t hash,
+                    unsigned tier = 0);
+  ComponentSet &add(FTL &&, EvalContext &, std::uint64_t hash,
+                    unsigned tier = 0);
+  ComponentSet &add(Sublight &&, EvalContext &, std::uint64_t hash,
+                    unsigned tier = 0);
+  ComponentSet &add(Sensor &&, EvalContext &, std::uint64_t hash,
+                    unsigned tier = 0);
+  ComponentSet &add(Computer &&, EvalContext &, std::uint64_t hash,
+                    unsigned tier = 0);
+  ComponentSet &add(Aura &&, EvalContext &, std::uint64_t hash,
+                    unsigned tier = 0);
+  ComponentSet &add(Utility &&, EvalContext &, std::uint64_t hash,
+                    unsigned tier = 0);
+  ComponentSet &add(Auxiliary &&, EvalContext &, std::uint64_t hash,
+                    unsigned tier = 0);
+  ComponentSet &add(Weapon &&, EvalContext &, std::uint64_t hash,
+                    unsigned tier = 0);
+
+  /**
+   * adds a component by name only; it's loaded the first time it's looked up
+   * by name, or by loadAll
+   *
+   * its id is given out here, so ids follow the order components are added or
+   * deferred in, no matter when they're loaded
+   */
+  ComponentSet &defer(std::string const &name, Loader<Hull> &&, EvalContext &,
+                      unsigned tier = 0);
+  ComponentSet &defer(std::string const &name, Loader<Section> &&,
+                      EvalContext &, unsigned tier = 0);
+  ComponentSet &defer(std::string const &name, Loader<Reactor> &&,
+                      EvalContext &, unsigned tier = 0);
+  ComponentSet &defer(std::string const &name, Loader<FTL> &&, EvalContext &,
+                      unsigned tier = 0);
+  ComponentSet &defer(std::string const &name, Loader<Sublight> &&,
+                      EvalContext &, unsigned tier = 0);
+  ComponentSet &defer(std::string const &name, Loader<Sensor> &&,
+                      EvalContext &, unsigned tier = 0);
+  ComponentSet &defer(std::string const &name, Loader<Computer> &&,
+                      EvalContext &, unsigned tier = 0);
+  ComponentSet &defer(std::string const &name, Loader<Aura> &&, EvalContext &,
+                      unsigned tier = 0);
+  ComponentSet &defer(std::string const &name, Loader<Utility> &&,
+                      EvalContext &, unsigned tier = 0);
+  ComponentSet &defer(std::string const &name, Loader<Auxiliary> &&,
+                      EvalContext &, unsigned tier = 0);
+  ComponentSet &defer(std::string const &name, Loader<Weapon> &&,
+                      EvalContext &, unsigned tier = 0);
+
+  /**
+   * loads every deferred component, in the order they were deferred
+   *
+   * views and the fingerprint only cover loaded components, and id lookups
+   * don't load anything, so anything that looks at the whole set should call
+   * this first
+   *
+   * @throws EvalException if a deferred component is invalid
+   */
+  void loadAll() const;
+
+  /**
+   * component with this name, or null if there is none; a deferred component
+   * is loaded here, which isn't safe to do from more than one thread
+   *
+   * @throws EvalException if a deferred component is invalid
+   */
+  Hull const *getHull(std::string const &name) const;
+  Section const *getSection(std::string const &name) const;
+  Reactor const *getReactor(std::string const &name) const;
+  FTL const *getFTL(std::string const &name) const;
+  Sublight const *getSublight(std::string const &name) const;
+  Sensor const *getSensor(std::string const &name) const;
+  Computer const *getComputer(std::string const &name) const;
+  Aura const *getAura(std::string const &name) const;
+  Utility const *getUtility(std::string const &name) const;
+  Auxiliary const *getAuxiliary(std::string const &name) const;
+  Weapon const *getWeapon(std::string const &name) const;
+
+  /**
+   * component with this id, or null if there is none or it isn't loaded yet
+   */
+  Hull const *getHull(ComponentId id) const noexcept;
+  Section const *getSection(ComponentId id) const noexcept;
+  Reactor const *getReactor(ComponentId id) const noexcept;
+  FTL const *getFTL(ComponentId id) const noexcept;
+  Sublight const *getSublight(ComponentId id) const noexcept;
+  Sensor const *getSensor(ComponentId id) const noexcept;
+  Computer const *getComputer(ComponentId id) const noexcept;
+  Aura const *getAura(ComponentId id) const noexcept;
+  Utility const *getUtility(ComponentId id) const noexcept;
+  Auxiliary const *getAuxiliary(ComponentId id) const noexcept;
+  Weapon const *getWeapon(ComponentId id) const noexcept;
+  /**
+   * combat stats of the weapon with this id, or null if there is none or it
+   * isn't loaded yet; the stats of all the weapons are stored together, in id
+   * order
+   */
+  Weapon::Stats const *getWeaponStats(ComponentId id) const noexcept;
+
+  /**
+   * id of a component of this set
+   */
+  ComponentId idOf(Hull const &) const noexcept;
+  ComponentId idOf(Section const &) const noexcept;
+  ComponentId idOf(Reactor const &) const noexcept;
+  ComponentId idOf(FTL const &) const noexcept;
+  ComponentId idOf(Sublight const &) const noexcept;
+  ComponentId idOf(Sensor const &) const noexcept;
+  ComponentId idOf(Computer const &) const noexcept;
+  ComponentId idOf(Aura const &) const noexcept;
+  ComponentId idOf(Utility const &) const noexcept;
+  ComponentId idOf(Auxiliary const &) const noexcept;
+  ComponentId idOf(Weapon const &) const noexcept;
+
+  /**
+   * hash of every loaded component's content hash, in id order; sets that
+   * give the same ids to the same components have the same fingerprint
+   */
+  std::uint64_t fingerprint() const noexcept;
+
+  /**
+   * the components of a type that pass a filter, without copying them
+   */
+  ComponentView<Hull> hullView(ComponentFilter const & = {}) const noexcept;
+  ComponentView<Section> sectionView(
+      ComponentFilter const & = {}) const noexcept;
+  ComponentView<Reactor> reactorView(
+      ComponentFilter const & = {}) const noexcept;
+  ComponentView<FTL> ftlView(ComponentFilter const & = {}) const noexcept;
+  ComponentView<Sublight> sublightView(
+      ComponentFilter const & = {}) const noexcept;
+  ComponentView<Sensor> sensorView(ComponentFilter const & = {}) const noexcept;
+  ComponentView<Computer> computerView(
+      ComponentFilter const & = {}) const noexcept;
+  ComponentView<Aura> auraView(ComponentFilter const & = {}) const noexcept;
+  ComponentView<Utility> utilityView(
+      ComponentFilter const & = {}) const noexcept;
+  ComponentView<Auxiliary> auxiliaryView(
+      ComponentFilter const & = {}) const noexcept;
+  ComponentView<Weapon> weaponView(ComponentFilter const & = {}) const noexcept;
+
+  /**
+   * hash of the data a component of this set was loaded from
+   */
+  std::uint64_t hashOf(Hull const &) const noexcept;
+  std::uint64_t hashOf(Section const &) const noexcept;
+  std::uint64_t hashOf(Reactor const &) const noexcept;
+  std::uint64_t hashOf(FTL const &) const noexcept;
+  std::uint64_t hashOf(Sublight const &) const noexcept;
+  std::uint64_t hashOf(Sensor const &) const noexcept;
+  std::uint64_t hashOf(Computer const &) const noexcept;
+  std::uint64_t hashOf(Aura const &) const noexcept;
+  std::uint64_t hashOf(Utility const &) const noexcept;
+  std::uint64_t hashOf(Auxiliary const &) const noexcept;
+  std::uint64_t hashOf(Weapon const &) const noexcept;
 
  private:
-  std::vector<Hull> hulls;
-  std::vector<Section> sections;
-  std::vector<Reactor> reactors;
-  std::vector<FTL> ftls;
-  std::vector<Sublight> sublights;
-  std::vector<Sensor> sensors;
-  std::vector<Computer> computers;
-  std::vector<Aura> auras;
-  std::vector<Utility> utilities;
-  std::vector<Auxiliary> auxiliaries;
-  std::vector<Weapon> weapons;
+  // loading a deferred component appends to these from const lookups, so
+  // they're in load order rather than id order; they have room reserved for
+  // every deferred component, so that never moves the components already
+  // handed out
+  mutable std::vector<Hull> hulls;
+  mutable std::vector<Section> sections;
+  mutable std::vector<Reactor> reactors;
+  mutable std::vector<FTL> ftls;
+  mutable std::vector<Sublight> sublights;
+  mutable std::vector<Sensor> sensors;
+  mutable std::vector<Computer> computers;
+  mutable std::vector<Aura> auras;
+  mutable std::vector<Utility> utilities;
+  mutable std::vector<Auxiliary> auxiliaries;
+  mutable std::vector<Weapon> weapons;
+
+  /**
+   * per-component data, in the same order as the components
+   */
+  struct Index {
+    std::vector<std::uint64_t> hashes;
+    std::vector<unsigned> tiers;
+    std::vector<ComponentId> ids;
+    /**
+     * places in the components, sorted by tier, and by id within a tier
+     */
+    std::vector<ComponentId> byTier;
+    /**
+     * place of the component with each id, or all ones if it isn't loaded yet
+     */
+    std::vector<ComponentId> places;
+  };
+
+  mutable Index hullIndex;
+  mutable Index sectionIndex;
+  mutable Index reactorIndex;
+  mutable Index ftlIndex;
+  mutable Index sublightIndex;
+  mutable Index sensorIndex;
+  mutable Index computerIndex;
+  mutable Index auraIndex;
+  mutable Index utilityIndex;
+  mutable Index auxiliaryIndex;
+  /**
+   * as Index, with each weapon's combat stats in id order, which the weapons
+   * point to; a deferred weapon's stats are filled in when it's loaded, so
+   * loading it never moves the table
+   */
+  struct WeaponIndex final : Index {
+    std::vector<Weapon::Stats> stats;
+  };
+
+  mutable WeaponIndex weaponIndex;
+
+  /**
+   * a component that's been named but not yet loaded
+   */
+  template <typename T>
+  struct Pending final {
+    std::string name;
+    Loader<T> load;
+    unsigned tier;
+    ComponentId id;
+  };
+
+  mutable std::vector<Pending<Hull>> pendingHulls;
+  mutable std::vector<Pending<Section>> pendingSections;
+  mutable std::vector<Pending<Reactor>> pendingReactors;
+  mutable std::vector<Pending<FTL>> pendingFTLs;
+  mutable std::vector<Pending<Sublight>> pendingSublights;
+  mutable std::vector<Pending<Sensor>> pendingSensors;
+  mutable std::vector<Pending<Computer>> pendingComputers;
+  mutable std::vector<Pending<Aura>> pendingAuras;
+  mutable std::vector<Pending<Utility>> pendingUtilities;
+  mutable std::vector<Pending<Auxiliary>> pendingAuxiliaries;
+  mutable std::vector<Pending<Weapon>> pendingWeapons;
 };
 }  // namespace athena2::model::component
 
@@ -0,0 +1,226 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ATHENA2_MODEL_COMPONENT_COMPONENTVIEW_H_
+#define ATHENA2_MODEL_COMPONENT_COMPONENTVIEW_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "model/component/aura.h"
+#include "model/component/auxiliary.h"
+#include "model/component/computer.h"
+#include "model/component/ftl.h"
+#include "model/component/hull.h"
+#include "model/component/reactor.h"
+#include "model/component/section.h"
+#include "model/component/sensor.h"
+#include "model/component/sublight.h"
+#include "model/component/utility.h"
+#include "model/component/weapon.h"
+
+namespace athena2::model::component {
+/**
+ * index of a component among those of its type in a component set, in the
+ * order they were added
+ */
+using ComponentId = std::uint16_t;
+
+/**
+ * which components of a type to look at
+ */
+struct ComponentFilter final {
+  /**
+   * inclusive tier range
+   */
+  unsigned minTier = 0;
+  unsigned maxTier = std::numeric_limits<unsigned>::max();
+  /**
+   * slot size the component must fit; empty for any. Hulls match their core
+   * size, and FTL drives and sensors fit every size
+   */
+  std::string size = "";
+  /**
+   * weapon tag; empty for any. Ignored for everything but weapons
+   */
+  std::string tag = "";
+};
+
+inline bool fitsSize(Hull const &hull, std::string const &size) noexcept {
+  return hull.coreSize == size;
+}
+inline bool fitsSize(Section const &section, std::string const &size) noexcept {
+  return section.size == size;
+}
+inline bool fitsSize(Reactor const &reactor, std::string const &size) noexcept {
+  return std::find(reactor.sizes.begin(), reactor.sizes.end(), size) !=
+         reactor.sizes.end();
+}
+inline bool fitsSize(FTL const &, std::string const &) noexcept { return true; }
+inline bool fitsSize(Sublight const &sublight,
+                     std::string const &size) noexcept {
+  return std::find(sublight.sizes.begin(), sublight.sizes.end(), size) !=
+         sublight.sizes.end();
+}
+inline bool fitsSize(Sensor const &, std::string const &) noexcept {
+  return true;
+}
+inline bool fitsSize(Computer const &computer,
+                     std::string const &size) noexcept {
+  return std::find(computer.sizes.begin(), computer.sizes.end(), size) !=
+         computer.sizes.end();
+}
+inline bool fitsSize(Aura const &aura, std::string const &size) noexcept {
+  return aura.size == size;
+}
+inline bool fitsSize(Utility const &utility, std::string const &size) noexcept {
+  return utility.size == size;
+}
+inline bool fitsSize(Auxiliary const &auxiliary,
+                     std::string const &size) noexcept {
+  return auxiliary.size == size;
+}
+inline bool fitsSize(Weapon const &weapon, std::string const &size) noexcept {
+  return weapon.size == size;
+}
+
+template <typename T>
+bool hasTag(T const &, std::string const &) noexcept {
+  return true;
+}
+inline bool hasTag(Weapon const &weapon, std::string const &tag) noexcept {
+  return weapon.tag == tag;
+}
+
+/**
+ * the components of one type in a component set that pass a filter
+ *
+ * views don't copy any components; they walk the set's tier index, which
+ * narrows them to the tier range up front, and skip components of the wrong
+ * size or tag as they go. Components come out in tier order, and in the
+ * order they were added within a tier. A view is invalidated by adding
+ * components to its set
+ */
+template <typename T>
+class ComponentView final {
+ public:
+  class iterator final {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T const *;
+    using reference = T const &;
+
+    iterator() noexcept = default;
+    iterator(ComponentView const *view_, ComponentId const *position_) noexcept
+        : view(view_), position(position_) {
+      skip();
+    }
+
+    reference operator*() const noexcept { return (*view->all)[*position]; }
+    pointer operator->() const noexcept { return &(*view->all)[*position]; }
+    iterator &operator++() noexcept {
+      ++position;
+      skip();
+      return *this;
+    }
+    iterator operator++(int) noexcept {
+      iterator old = *this;
+      ++*this;
+      return old;
+    }
+    bool operator==(iterator const &other) const noexcept {
+      return position == other.position;
+    }
+
+   private:
+    void skip() noexcept {
+      while (position != view->last && !view->fits((*view->all)[*position]))
+        ++position;
+    }
+
+    ComponentView const *view = nullptr;
+    ComponentId const *position = nullptr;
+  };
+
+  ComponentView(std::vector<T> const &all_, std::vector<unsigned> const &tiers_,
+                std::vector<ComponentId> const &byTier,
+                ComponentFilter const &filter_) noexcept
+      : all(&all_), tiers(&tiers_), first(), last(), filter(filter_) {
+    auto tierOf = [this](ComponentId id) { return (*tiers)[id]; };
+    first = byTier.data() +
+            (std::ranges::lower_bound(byTier, filter.minTier, {}, tierOf) -
+             byTier.begin());
+    last = byTier.data() +
+           (std::ranges::upper_bound(byTier, filter.maxTier, {}, tierOf) -
+            byTier.begin());
+  }
+  ComponentView(ComponentView const &) noexcept = default;
+  ComponentView(ComponentView &&) noexcept = default;
+
+  ~ComponentView() noexcept = default;
+
+  ComponentView &operator=(ComponentView const &) noexcept = default;
+  ComponentView &operator=(ComponentView &&) noexcept = default;
+
+  iterator begin() const noexcept { return iterator(this, first); }
+  iterator end() const noexcept { return iterator(this, last); }
+
+  /**
+   * true if a component of the set this views passes the filter
+   */
+  bool matches(T const &component) const noexcept {
+    unsigned tier =
+        (*tiers)[static_cast<std::size_t>(&component - all->data())];
+    return filter.minTier <= tier && tier <= filter.maxTier && fits(component);
+  }
+  /**
+   * the component in this view with this name, or null if there is none
+   */
+  T const *get(std::string const &name) const noexcept {
+    auto found = std::find_if(begin(), end(), [&name](T const &component) {
+      return component.name == name;
+    });
+    return found == end() ? nullptr : &*found;
+  }
+
+ private:
+  /**
+   * true if the component passes the size and tag filters
+   */
+  bool fits(T const &component) const noexcept {
+    return (filter.size.empty() || fitsSize(component, filter.size)) &&
+           (filter.tag.empty() || hasTag(component, filter.tag));
+  }
+
+  std::vector<T> const *all;
+  std::vector<unsigned> const *tiers;
+  ComponentId const *first;
+  ComponentId const *last;
+  ComponentFilter filter;
+};
+}  // namespace athena2::model::component
+
+#endif  // ATHENA2_MODEL_COMPONENT_COMPONENTVIEW_H_
@@ -22,6 +22,7 @@
 #include <optional>
 #include <unordered_map>
 
+#include "model/component/sizeClass.h"
 #include "util/json.h"
 
 using namespace std;
@@ -43,6 +44,10 @@ Computer Computer::fromJson(json const &data, EvalContext &ctx) {
   checkObject(data, ctx);
   string name = checkString(data, "name", ctx);
   vector<string> sizes = checkStringArray(data, "sizes", ctx);
+  uint64_t sizeMask = [&sizes, &ctx]() {
+    auto _ = ctx.push("sizes");
+    return coreSizeMask(sizes, ctx);
+  }();
   string tacticsName = checkString(data, "tactics", ctx);
   auto tactics = tacticsNames.find(tacticsName);
   {
@@ -80,21 +85,24 @@ Computer Computer::fromJson(json const &data, EvalContext &ctx) {
       ctx);
 
   return Computer(
-      name, sizes, tactics->second, power, fireRateModifier.value_or(0.f),
-      evasionModifier.value_or(0.f), sublightSpeedModifier.value_or(0.f),
+      name, sizes, sizeMask, tactics->second, power,
+      fireRateModifier.value_or(0.f), evasionModifier.value_or(0.f),
+      sublightSpeedModifier.value_or(0.f),
       explosiveWeaponsDamageModifier.value_or(0.f), trackingBonus.value_or(0.f),
       chanceToHitBonus.value_or(0.f), weaponsRangeModifier.value_or(0.f),
       engagementRangeModifier.value_or(0.f), cost);
 }
 Computer::Computer(string const &name_, vector<string> const &sizes_,
-                   Computer::Tactics tactics_, float power_,
-                   float fireRateModifier_, float evasionModifier_,
+                   uint64_t sizeMask_, Computer::Tactics tactics_,
+                   float power_, float fireRateModifier_,
+                   float evasionModifier_,
                    float sublightSpeedModifier_,
                    float explosiveWeaponsDamageModifier_, float trackingBonus_,
                    float chanceToHitBonus_, float weaponsRangeModifier_,
                    float engagementRangeModifier_, Cost const &cost_) noexcept
     : Named(name_),
       sizes(sizes_),
+      sizeMask(sizeMask_),
       tactics(tactics_),
       power(power_),
       fireRateModifier(fireRateModifier_),
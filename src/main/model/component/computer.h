@@ -20,6 +20,7 @@
 #ifndef ATHENA2_MODEL_COMPONENT_COMPUTER_H_
 #define ATHENA2_MODEL_COMPONENT_COMPUTER_H_
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -51,6 +52,7 @@ class Computer final : public util::Named {
   Computer &operator=(Computer &&) noexcept = default;
 
   std::vector<std::string> const sizes;
+  std::uint64_t const sizeMask;
   Tactics tactics;
   float const power;
   float const fireRateModifier;
@@ -65,8 +67,9 @@ class Computer final : public util::Named {
 
  private:
   Computer(std::string const &name, std::vector<std::string> const &sizes,
-           Tactics tactics, float power, float fireRateModifier,
-           float evasionModifier, float sublightSpeedModifier,
+           std::uint64_t sizeMask, Tactics tactics, float power,
+           float fireRateModifier, float evasionModifier,
+           float sublightSpeedModifier,
            float explosiveWeaponsDamageModifier, float trackingBonus,
            float chanceToHitBonus, float weaponsRangeModifier,
            float engagementRangeModifier, Cost const &cost) noexcept;
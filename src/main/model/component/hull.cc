@@ -21,8 +21,10 @@
 
 #include <algorithm>
 #include <optional>
+#include <string>
 #include <vector>
 
+#include "model/component/sizeClass.h"
 #include "nlohmann/json.hpp"
 #include "util/json.h"
 
@@ -37,6 +39,20 @@ Hull Hull::fromJson(nlohmann::json const &data, EvalContext &ctx) {
   float size = checkFloat(data, "size", ctx);
   string coreSize = checkString(data, "coreSize", ctx);
   vector<string> sectionSizes = checkStringArray(data, "sectionSizes", ctx);
+  uint64_t coreSizeBit = [&coreSize, &ctx]() {
+    auto _ = ctx.push("coreSize");
+    return component::coreSizeBit(coreSize, ctx);
+  }();
+  SlotSet sectionSlotSet = [&sectionSizes, &ctx]() {
+    auto _ = ctx.push("sectionSizes");
+    if (sectionSizes.size() > SlotSet::MAX_COUNT)
+      ctx.error("expected at most " + to_string(SlotSet::MAX_COUNT) +
+                " section slots");
+    SlotSet slots;
+    for (string const &sectionSize : sectionSizes)
+      slots.addLane(sectionSizeLane(sectionSize, ctx));
+    return slots;
+  }();
   float hullHealth = checkFloat(data, "hullHealth", ctx);
   optional<float> hullHealthModifier =
       checkMaybeFloat(data, "hullHealthModifier", ctx);
@@ -63,7 +79,8 @@ Hull Hull::fromJson(nlohmann::json const &data, EvalContext &ctx) {
                "disengageChanceModifier", "includeComponentCost", "cost"},
               ctx);
 
-  return Hull(name, size, coreSize, sectionSizes, hullHealth,
+  return Hull(name, size, coreSize, sectionSizes, coreSizeBit, sectionSlotSet,
+              hullHealth,
               hullHealthModifier.value_or(0.f), armourHealth.value_or(0.f),
               evasion, evasionModifier.value_or(0.f),
               trackingModifier.value_or(0.f), speed, disengageChanceModifier,
@@ -71,7 +88,8 @@ Hull Hull::fromJson(nlohmann::json const &data, EvalContext &ctx) {
 }
 
 Hull::Hull(string const &name_, float size_, string const &coreSize_,
-           vector<string> const &sectionSizes_, float hullHealth_,
+           vector<string> const &sectionSizes_, uint64_t coreSizeBit_,
+           SlotSet const &sectionSlotSet_, float hullHealth_,
            float hullHealthModifier_, float armourHealth_, float evasion_,
            float evasionModifier_, float trackingModifier_, float speed_,
            float disengageChanceModifier_, bool includeComponentCost_,
@@ -84,6 +102,8 @@ Hull::Hull(string const &name_, float size_, string const &coreSize_,
         sort(sectionSizes.begin(), sectionSizes.end());
         return sectionSizes;
       }()),
+      coreSizeBit(coreSizeBit_),
+      sectionSlotSet(sectionSlotSet_),
       hullHealth(hullHealth_),
       hullHealthModifier(hullHealthModifier_),
       armourHealth(armourHealth_),
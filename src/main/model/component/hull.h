@@ -26,6 +26,7 @@
 #include <vector>
 
 #include "dsl.h"
+#include "model/component/slotSet.h"
 #include "model/economy.h"
 #include "util/named.h"
 
@@ -45,6 +46,8 @@ class Hull final : public util::Named {
   float const size;
   std::string const coreSize;
   std::vector<std::string> const sectionSizes;
+  std::uint64_t const coreSizeBit;
+  SlotSet const sectionSlotSet;
   float const hullHealth;
   float const hullHealthModifier;
   float const armourHealth;
@@ -58,7 +61,9 @@ class Hull final : public util::Named {
 
  private:
   Hull(std::string const &name, float size, std::string const &coreSize,
-       std::vector<std::string> const &sectionSizes, float hullHealth,
+       std::vector<std::string> const &sectionSizes,
+       std::uint64_t coreSizeBit, SlotSet const &sectionSlotSet,
+       float hullHealth,
        float hullHealthModifier, float armourHealth, float evasion,
        float evasionModifier, float trackingModifier, float speed,
        float disengageChanceModifier, bool includeComponentCost,
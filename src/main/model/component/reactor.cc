@@ -19,6 +19,7 @@
 
 #include "model/component/reactor.h"
 
+#include "model/component/sizeClass.h"
 #include "util/json.h"
 
 using namespace std;
@@ -30,6 +31,10 @@ Reactor Reactor::fromJson(json const &data, EvalContext &ctx) {
   checkObject(data, ctx);
   string name = checkString(data, "name", ctx);
   vector<string> sizes = checkStringArray(data, "sizes", ctx);
+  uint64_t sizeMask = [&sizes, &ctx]() {
+    auto _ = ctx.push("sizes");
+    return coreSizeMask(sizes, ctx);
+  }();
   float power = checkFloat(data, "power", ctx);
   json const &costData = checkObject(data, "cost", ctx);
   Cost cost = [&ctx, &costData]() {
@@ -38,9 +43,13 @@ Reactor Reactor::fromJson(json const &data, EvalContext &ctx) {
   }();
   checkFields(data, {"name", "sizes", "power", "cost"}, ctx);
 
-  return Reactor(name, sizes, power, cost);
+  return Reactor(name, sizes, sizeMask, power, cost);
 }
 Reactor::Reactor(string const &name_, vector<string> const &sizes_,
-                 float power_, Cost const &cost_) noexcept
-    : Named(name_), sizes(sizes_), power(power_), cost(cost_) {}
+                 uint64_t sizeMask_, float power_, Cost const &cost_) noexcept
+    : Named(name_),
+      sizes(sizes_),
+      sizeMask(sizeMask_),
+      power(power_),
+      cost(cost_) {}
 }  // namespace athena2::model::component
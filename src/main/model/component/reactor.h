@@ -20,6 +20,7 @@
 #ifndef ATHENA2_MODEL_COMPONENT_REACTOR_H_
 #define ATHENA2_MODEL_COMPONENT_REACTOR_H_
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -42,12 +43,13 @@ class Reactor final : public util::Named {
   Reactor &operator=(Reactor &&) noexcept = default;
 
   std::vector<std::string> const sizes;
+  std::uint64_t const sizeMask;
   float const power;
   Cost const cost;
 
  private:
   Reactor(std::string const &name, std::vector<std::string> const &sizes,
-          float power, Cost const &cost) noexcept;
+          std::uint64_t sizeMask, float power, Cost const &cost) noexcept;
 };
 }  // namespace athena2::model::component
 
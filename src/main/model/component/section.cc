@@ -20,7 +20,9 @@
 #include "model/component/section.h"
 
 #include <algorithm>
+#include <string>
 
+#include "model/component/sizeClass.h"
 #include "util/json.h"
 
 using namespace std;
@@ -28,12 +30,36 @@ using namespace nlohmann;
 using namespace athena2::util;
 
 namespace athena2::model::component {
+namespace {
+/**
+ * slots must be capital letters, and few enough for a SlotSet to count
+ */
+void checkSlots(string const &slots, EvalContext &ctx) {
+  if (slots.size() > SlotSet::MAX_COUNT)
+    ctx.error("expected at most " + to_string(SlotSet::MAX_COUNT) + " slots");
+  if (!all_of(slots.begin(), slots.end(), SlotSet::isSize))
+    ctx.error("expected slot sizes to be capital letters");
+}
+}  // namespace
+
 Section Section::fromJson(json const &data, EvalContext &ctx) {
   checkObject(data, ctx);
   string name = checkString(data, "name", ctx);
   string size = checkString(data, "size", ctx);
+  size_t sizeLane = [&size, &ctx]() {
+    auto _ = ctx.push("size");
+    return sectionSizeLane(size, ctx);
+  }();
   string weaponSlots = checkString(data, "weaponSlots", ctx);
+  {
+    auto _ = ctx.push("weaponSlots");
+    checkSlots(weaponSlots, ctx);
+  }
   string utilitySlots = checkString(data, "utilitySlots", ctx);
+  {
+    auto _ = ctx.push("utilitySlots");
+    checkSlots(utilitySlots, ctx);
+  }
   json const *costData = checkMaybeObject(data, "cost", ctx);
   Cost cost = costData ? [&ctx, &costData]() {
     auto _ = ctx.push("cost");
@@ -42,13 +68,14 @@ Section Section::fromJson(json const &data, EvalContext &ctx) {
   checkFields(data, {"name", "size", "weaponSlots", "utilitySlots", "cost"},
               ctx);
 
-  return Section(name, size, weaponSlots, utilitySlots, cost);
+  return Section(name, size, sizeLane, weaponSlots, utilitySlots, cost);
 }
-Section::Section(string const &name_, string const &size_,
+Section::Section(string const &name_, string const &size_, size_t sizeLane_,
                  string const &weaponSlots_, string const &utilitySlots_,
                  Cost const &cost_) noexcept
     : Named(name_),
       size(size_),
+      sizeLane(sizeLane_),
       weaponSlots([&weaponSlots_]() {
         string weaponSlots = weaponSlots_;
         sort(weaponSlots.begin(), weaponSlots.end());
@@ -59,5 +86,7 @@ Section::Section(string const &name_, string const &size_,
         sort(utilitySlots.begin(), utilitySlots.end());
         return utilitySlots;
       }()),
-      cost(cost_) {}
+      cost(cost_),
+      weaponSlotSet(weaponSlots),
+      utilitySlotSet(utilitySlots) {}
 }  // namespace athena2::model::component
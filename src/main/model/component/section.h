@@ -20,9 +20,11 @@
 #ifndef ATHENA2_MODEL_COMPONENT_SECTION_H_
 #define ATHENA2_MODEL_COMPONENT_SECTION_H_
 
+#include <cstddef>
 #include <string>
 
 #include "dsl.h"
+#include "model/component/slotSet.h"
 #include "model/economy.h"
 #include "nlohmann/json.hpp"
 #include "util/named.h"
@@ -41,14 +43,17 @@ class Section final : public util::Named {
   Section &operator=(Section &&) noexcept = default;
 
   std::string const size;
+  std::size_t const sizeLane;
   std::string const weaponSlots;
   std::string const utilitySlots;
   Cost const cost;
+  SlotSet const weaponSlotSet;
+  SlotSet const utilitySlotSet;
 
  private:
   Section(std::string const &name, std::string const &size,
-          std::string const &weaponSlots, std::string const &utilitySlots,
-          Cost const &cost) noexcept;
+          std::size_t sizeLane, std::string const &weaponSlots,
+          std::string const &utilitySlots, Cost const &cost) noexcept;
 };
 }  // namespace athena2::model::component
 
@@ -0,0 +1,73 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/component/sizeClass.h"
+
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+
+#include "model/component/slotSet.h"
+
+using namespace std;
+
+namespace athena2::model::component {
+namespace {
+/**
+ * size names in the order they were first seen; a name's number is its place
+ */
+class SizeNames final {
+ public:
+  explicit SizeNames(size_t limit_) noexcept
+      : names(), namesMutex(), limit(limit_) {}
+
+  size_t number(string const &size, char const *kind, EvalContext &ctx) {
+    lock_guard lock(namesMutex);
+    auto found = find(names.begin(), names.end(), size);
+    if (found != names.end())
+      return static_cast<size_t>(distance(names.begin(), found));
+    if (names.size() == limit)
+      ctx.error("too many "s + kind + " sizes; can't add '" + size + "'");
+    names.push_back(size);
+    return names.size() - 1;
+  }
+
+ private:
+  vector<string> names;
+  mutex namesMutex;
+  size_t const limit;
+};
+
+// components are loaded independently, so the numbering is shared by all
+SizeNames sectionSizes(SlotSet::LANES);
+SizeNames coreSizes(64);
+}  // namespace
+
+size_t sectionSizeLane(string const &size, EvalContext &ctx) {
+  return sectionSizes.number(size, "section", ctx);
+}
+uint64_t coreSizeBit(string const &size, EvalContext &ctx) {
+  return uint64_t{1} << coreSizes.number(size, "core", ctx);
+}
+uint64_t coreSizeMask(vector<string> const &sizes, EvalContext &ctx) {
+  uint64_t mask = 0;
+  for (string const &size : sizes) mask |= coreSizeBit(size, ctx);
+  return mask;
+}
+}  // namespace athena2::model::component
@@ -0,0 +1,56 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ATHENA2_MODEL_COMPONENT_SIZECLASS_H_
+#define ATHENA2_MODEL_COMPONENT_SIZECLASS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "dsl.h"
+
+namespace athena2::model::component {
+/**
+ * the SlotSet lane a section size takes; every hull and section that names
+ * the same size gets the same lane
+ *
+ * @throws EvalException if there are more section sizes than SlotSet lanes
+ */
+std::size_t sectionSizeLane(std::string const &size, EvalContext &ctx);
+
+/**
+ * the bit a core size takes in a core size mask; every component that names
+ * the same size gets the same bit
+ *
+ * @throws EvalException if there are more than 64 core sizes
+ */
+std::uint64_t coreSizeBit(std::string const &size, EvalContext &ctx);
+
+/**
+ * the core size bits of every size listed
+ *
+ * @throws EvalException if there are more than 64 core sizes
+ */
+std::uint64_t coreSizeMask(std::vector<std::string> const &sizes,
+                           EvalContext &ctx);
+}  // namespace athena2::model::component
+
+#endif  // ATHENA2_MODEL_COMPONENT_SIZECLASS_H_
@@ -0,0 +1,87 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ATHENA2_MODEL_COMPONENT_SLOTSET_H_
+#define ATHENA2_MODEL_COMPONENT_SLOTSET_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace athena2::model::component {
+/**
+ * multiset of slot sizes, stored as an 8 bit count per size
+ *
+ * sizes are capital letters; each letter gets its own lane. Counts must
+ * stay at or below MAX_COUNT for fitsIn to be exact
+ */
+class SlotSet final {
+ public:
+  static constexpr std::size_t LANES = 32;
+  static constexpr std::size_t MAX_COUNT = 127;
+
+  /**
+   * true if size can be a slot size; other characters would share a lane
+   */
+  static constexpr bool isSize(char size) noexcept {
+    return 'A' <= size && size <= 'Z';
+  }
+
+  SlotSet() noexcept : counts() {}
+  explicit SlotSet(std::string_view sizes) noexcept : counts() {
+    for (char size : sizes) add(size);
+  }
+  SlotSet(SlotSet const &) noexcept = default;
+  SlotSet(SlotSet &&) noexcept = default;
+
+  ~SlotSet() noexcept = default;
+
+  SlotSet &operator=(SlotSet const &) noexcept = default;
+  SlotSet &operator=(SlotSet &&) noexcept = default;
+
+  void add(char size) noexcept {
+    addLane(static_cast<unsigned char>(size) % LANES);
+  }
+  /**
+   * adds a slot to the given lane, which must be below LANES
+   */
+  void addLane(std::size_t lane) noexcept {
+    counts[lane / 8] += std::uint64_t{1} << (lane % 8 * 8);
+  }
+
+  /**
+   * true if there is a slot in capacity for every slot in this set
+   */
+  bool fitsIn(SlotSet const &capacity) const noexcept {
+    // a lane's high bit survives the subtraction only if there are enough
+    // slots, and no lane borrows from the next
+    constexpr std::uint64_t HIGH_BITS = 0x8080808080808080;
+    std::uint64_t lacking = 0;
+    for (std::size_t idx = 0; idx < counts.size(); ++idx)
+      lacking |= ~((capacity.counts[idx] | HIGH_BITS) - counts[idx]);
+    return (lacking & HIGH_BITS) == 0;
+  }
+
+ private:
+  std::array<std::uint64_t, LANES / 8> counts;
+};
+}  // namespace athena2::model::component
+
+#endif  // ATHENA2_MODEL_COMPONENT_SLOTSET_H_
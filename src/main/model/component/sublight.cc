@@ -19,6 +19,7 @@
 
 #include "model/component/sublight.h"
 
+#include "model/component/sizeClass.h"
 #include "util/json.h"
 
 using namespace std;
@@ -30,6 +31,10 @@ Sublight Sublight::fromJson(json const &data, EvalContext &ctx) {
   checkObject(data, ctx);
   string name = checkString(data, "name", ctx);
   vector<string> sizes = checkStringArray(data, "sizes", ctx);
+  uint64_t sizeMask = [&sizes, &ctx]() {
+    auto _ = ctx.push("sizes");
+    return coreSizeMask(sizes, ctx);
+  }();
   float power = checkFloat(data, "power", ctx);
   float sublightSpeedModifier = checkFloat(data, "sublightSpeedModifier", ctx);
   float evasionBonus = checkFloat(data, "evasionBonus", ctx);
@@ -43,14 +48,16 @@ Sublight Sublight::fromJson(json const &data, EvalContext &ctx) {
                "evasionBonus", "cost"},
               ctx);
 
-  return Sublight(name, sizes, power, sublightSpeedModifier, evasionBonus,
-                  cost);
+  return Sublight(name, sizes, sizeMask, power, sublightSpeedModifier,
+                  evasionBonus, cost);
 }
 Sublight::Sublight(string const &name_, vector<string> const &sizes_,
-                   float power_, float sublightSpeedModifier_,
-                   float evasionBonus_, Cost const &cost_) noexcept
+                   uint64_t sizeMask_, float power_,
+                   float sublightSpeedModifier_, float evasionBonus_,
+                   Cost const &cost_) noexcept
     : Named(name_),
       sizes(sizes_),
+      sizeMask(sizeMask_),
       power(power_),
       sublightSpeedModifier(sublightSpeedModifier_),
       evasionBonus(evasionBonus_),
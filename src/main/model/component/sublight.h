@@ -20,6 +20,7 @@
 #ifndef ATHENA2_MODEL_COMPONENT_SUBLIGHT_H_
 #define ATHENA2_MODEL_COMPONENT_SUBLIGHT_H_
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -42,6 +43,7 @@ class Sublight final : public util::Named {
   Sublight &operator=(Sublight &&) noexcept = default;
 
   std::vector<std::string> const sizes;
+  std::uint64_t const sizeMask;
   float const power;
   float const sublightSpeedModifier;
   float const evasionBonus;
@@ -49,8 +51,8 @@ class Sublight final : public util::Named {
 
  private:
   Sublight(std::string const &name, std::vector<std::string> const &sizes,
-           float power, float sublightSpeedModifier, float evasionBonus,
-           Cost const &cost) noexcept;
+           std::uint64_t sizeMask, float power, float sublightSpeedModifier,
+           float evasionBonus, Cost const &cost) noexcept;
 };
 }  // namespace athena2::model::component
 
@@ -21,6 +21,7 @@
 
 #include <optional>
 
+#include "model/component/slotSet.h"
 #include "util/json.h"
 
 using namespace std;
@@ -34,7 +35,8 @@ Utility Utility::fromJson(json const &data, EvalContext &ctx) {
   string size = checkString(data, "size", ctx);
   {
     auto _ = ctx.push("size");
-    if (size.size() != 1) ctx.error("expected size to be a single character");
+    if (size.size() != 1 || !SlotSet::isSize(size[0]))
+      ctx.error("expected size to be a single capital letter");
   }
   optional<float> power = checkMaybeFloat(data, "power", ctx);
   optional<float> shieldHealth = checkMaybeFloat(data, "shieldHealth", ctx);
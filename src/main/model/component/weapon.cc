@@ -19,6 +19,7 @@
 
 #include "model/component/weapon.h"
 
+#include "model/component/slotSet.h"
 #include "util/json.h"
 
 using namespace std;
@@ -32,7 +33,8 @@ Weapon Weapon::fromJson(json const &data, EvalContext &ctx) {
   string size = checkString(data, "size", ctx);
   {
     auto _ = ctx.push("size");
-    if (size.size() != 1) ctx.error("expected size to be a single character");
+    if (size.size() != 1 || !SlotSet::isSize(size[0]))
+      ctx.error("expected size to be a single capital letter");
   }
   string tag = checkString(data, "tag", ctx);
   float power = checkFloat(data, "power", ctx);
@@ -55,6 +57,25 @@ Weapon Weapon::fromJson(json const &data, EvalContext &ctx) {
       checkMaybeFloat(data, "hullDamageModifier", ctx);
   optional<float> sizeDamageModifier =
       checkMaybeFloat(data, "sizeDamageModifier", ctx);
+  Stats stats{
+      .minDamage = minDamage,
+      .maxDamage = maxDamage,
+      .minRange = minRange,
+      .maxRange = maxRange,
+      .tracking = tracking,
+      .accuracy = accuracy,
+      .cooldown = cooldown,
+      .shieldDamageModifier = shieldDamageModifier.value_or(0.f),
+      .shieldSkipModifier = shieldSkipModifier.value_or(0.f),
+      .armourDamageModifier = armourDamageModifier.value_or(0.f),
+      .armourSkipModifier = armourSkipModifier.value_or(0.f),
+      .hullDamageModifier = hullDamageModifier.value_or(0.f),
+      .sizeDamageModifier = sizeDamageModifier.value_or(0.f),
+      .type = Type::REGULAR,
+      .explosive = tag == "explosive",
+      .pointDefence = tag == "point-defence",
+      .data{.regularWeapon{}},
+  };
   json const &costData = checkObject(data, "cost", ctx);
   Cost cost = [&ctx, &costData]() {
     auto _ = ctx.push("cost");
@@ -94,13 +115,15 @@ Weapon Weapon::fromJson(json const &data, EvalContext &ctx) {
                  "cost"},
                 ctx);
 
-    return Weapon(
-        name, size, tag, power, minDamage, maxDamage, minRange, maxRange,
-        tracking, accuracy, cooldown, shieldDamageModifier.value_or(0.f),
-        shieldSkipModifier.value_or(0.f), armourDamageModifier.value_or(0.f),
-        armourSkipModifier.value_or(0.f), hullDamageModifier.value_or(0.f),
-        sizeDamageModifier.value_or(0.f), projectileSpeed, projectileEvasion,
-        projectileRetargetRange, projectileHull, projectileArmour, cost);
+    stats.type = Type::PROJECTILE;
+    stats.data.projectileWeapon = {
+        .projectileSpeed = projectileSpeed,
+        .projectileEvasion = projectileEvasion,
+        .projectileRetargetRange = projectileRetargetRange,
+        .projectileHull = projectileHull,
+        .projectileArmour = projectileArmour,
+    };
+    return Weapon(name, size, tag, power, stats, cost);
   } else if (data.contains("unitsPerHangar")) {
     // hangar weapon
     float unitsPerHangar = checkFloat(data, "unitsPerHangar", ctx);
@@ -140,14 +163,19 @@ Weapon Weapon::fromJson(json const &data, EvalContext &ctx) {
                  "cost"},
                 ctx);
 
-    return Weapon(
-        name, size, tag, power, minDamage, maxDamage, minRange, maxRange,
-        tracking, accuracy, cooldown, shieldDamageModifier.value_or(0.f),
-        shieldSkipModifier.value_or(0.f), armourDamageModifier.value_or(0.f),
-        armourSkipModifier.value_or(0.f), hullDamageModifier.value_or(0.f),
-        sizeDamageModifier.value_or(0.f), unitsPerHangar, regenerationPerDay,
-        strikeCraftRange, strikeCraftSpeed, strikeCraftEvasion,
-        strikeCraftShield, strikeCraftArmour, strikeCraftHull, cost);
+    stats.type = Type::HANGAR;
+    stats.data.hangarWeapon = {
+        .unitsPerHangar = unitsPerHangar,
+        // NOTE: in-combat regen is 20% of listed regen
+        .regenerationPerDay = regenerationPerDay * 0.2f,
+        .strikeCraftRange = strikeCraftRange,
+        .strikeCraftSpeed = strikeCraftSpeed,
+        .strikeCraftEvasion = strikeCraftEvasion,
+        .strikeCraftShield = strikeCraftShield,
+        .strikeCraftArmour = strikeCraftArmour,
+        .strikeCraftHull = strikeCraftHull,
+    };
+    return Weapon(name, size, tag, power, stats, cost);
   } else {
     // regular weapon
     checkFields(
@@ -158,120 +186,23 @@ Weapon Weapon::fromJson(json const &data, EvalContext &ctx) {
          "hullDamageModifier", "sizeDamageModifier", "cost"},
         ctx);
 
-    return Weapon(
-        name, size, tag, power, minDamage, maxDamage, minRange, maxRange,
-        tracking, accuracy, cooldown, shieldDamageModifier.value_or(0.f),
-        shieldSkipModifier.value_or(0.f), armourDamageModifier.value_or(0.f),
-        armourSkipModifier.value_or(0.f), hullDamageModifier.value_or(0.f),
-        sizeDamageModifier.value_or(0.f), cost);
+    return Weapon(name, size, tag, power, stats, cost);
   }
 }
 Weapon::Weapon(string const &name_, string const &size_, string const &tag_,
-               float power_, float minDamage_, float maxDamage_,
-               float minRange_, float maxRange_, float tracking_,
-               float accuracy_, float cooldown_, float shieldDamageModifier_,
-               float shieldSkipModifier_, float armourDamageModifier_,
-               float armourSkipModifier_, float hullDamageModifier_,
-               float sizeDamageModifier_, Cost const &cost_) noexcept
+               float power_, Stats const &stats_, Cost const &cost_) noexcept
     : Named(name_),
+      stats(nullptr),
       size(size_),
       tag(tag_),
       power(power_),
-      minDamage(minDamage_),
-      maxDamage(maxDamage_),
-      minRange(minRange_),
-      maxRange(maxRange_),
-      tracking(tracking_),
-      accuracy(accuracy_),
-      cooldown(cooldown_),
-      shieldDamageModifier(shieldDamageModifier_),
-      shieldSkipModifier(shieldSkipModifier_),
-      armourDamageModifier(armourDamageModifier_),
-      armourSkipModifier(armourSkipModifier_),
-      hullDamageModifier(hullDamageModifier_),
-      sizeDamageModifier(sizeDamageModifier_),
-      type(Weapon::Type::REGULAR),
-      data{.regularWeapon{}},
-      cost(cost_) {}
-Weapon::Weapon(string const &name_, string const &size_, string const &tag_,
-               float power_, float minDamage_, float maxDamage_,
-               float minRange_, float maxRange_, float tracking_,
-               float accuracy_, float cooldown_, float shieldDamageModifier_,
-               float shieldSkipModifier_, float armourDamageModifier_,
-               float armourSkipModifier_, float hullDamageModifier_,
-               float sizeDamageModifier_, float projectileSpeed_,
-               float projectileEvasion_, float projectileRetargetRange_,
-               float projectileHull_, float projectileArmour_,
-               Cost const &cost_) noexcept
-    : Named(name_),
-      size(size_),
-      tag(tag_),
-      power(power_),
-      minDamage(minDamage_),
-      maxDamage(maxDamage_),
-      minRange(minRange_),
-      maxRange(maxRange_),
-      tracking(tracking_),
-      accuracy(accuracy_),
-      cooldown(cooldown_),
-      shieldDamageModifier(shieldDamageModifier_),
-      shieldSkipModifier(shieldSkipModifier_),
-      armourDamageModifier(armourDamageModifier_),
-      armourSkipModifier(armourSkipModifier_),
-      hullDamageModifier(hullDamageModifier_),
-      sizeDamageModifier(sizeDamageModifier_),
-      type(Weapon::Type::PROJECTILE),
-      data{
-          .projectileWeapon{
-              .projectileSpeed = projectileSpeed_,
-              .projectileEvasion = projectileEvasion_,
-              .projectileRetargetRange = projectileRetargetRange_,
-              .projectileHull = projectileHull_,
-              .projectileArmour = projectileArmour_,
-          },
-      },
-      cost(cost_) {}
-Weapon::Weapon(string const &name_, string const &size_, string const &tag_,
-               float power_, float minDamage_, float maxDamage_,
-               float minRange_, float maxRange_, float tracking_,
-               float accuracy_, float cooldown_, float shieldDamageModifier_,
-               float shieldSkipModifier_, float armourDamageModifier_,
-               float armourSkipModifier_, float hullDamageModifier_,
-               float sizeDamageModifier_, float unitsPerHangar_,
-               float regenerationPerDay_, float strikeCraftRange_,
-               float strikeCraftSpeed_, float strikeCraftEvasion_,
-               float strikeCraftShield_, float strikeCraftArmour_,
-               float strikeCraftHull_, Cost const &cost_) noexcept
-    : Named(name_),
-      size(size_),
-      tag(tag_),
-      power(power_),
-      minDamage(minDamage_),
-      maxDamage(maxDamage_),
-      minRange(minRange_),
-      maxRange(maxRange_),
-      tracking(tracking_),
-      accuracy(accuracy_),
-      cooldown(cooldown_),
-      shieldDamageModifier(shieldDamageModifier_),
-      shieldSkipModifier(shieldSkipModifier_),
-      armourDamageModifier(armourDamageModifier_),
-      armourSkipModifier(armourSkipModifier_),
-      hullDamageModifier(hullDamageModifier_),
-      sizeDamageModifier(sizeDamageModifier_),
-      type(Weapon::Type::HANGAR),
-      data{
-          .hangarWeapon{
-              .unitsPerHangar = unitsPerHangar_,
-              // NOTE: in-combat regen is 20% of listed regen
-              .regenerationPerDay = regenerationPerDay_ * 0.2f,
-              .strikeCraftRange = strikeCraftRange_,
-              .strikeCraftSpeed = strikeCraftSpeed_,
-              .strikeCraftEvasion = strikeCraftEvasion_,
-              .strikeCraftShield = strikeCraftShield_,
-              .strikeCraftArmour = strikeCraftArmour_,
-              .strikeCraftHull = strikeCraftHull_,
-          },
-      },
-      cost(cost_) {}
+      cost(cost_),
+      ownStats(make_unique<Stats const>(stats_)) {
+  stats = ownStats.get();
+}
+void Weapon::moveStatsTo(Stats &slot) noexcept {
+  slot = *stats;
+  stats = &slot;
+  ownStats.reset();
+}
 }  // namespace athena2::model::component
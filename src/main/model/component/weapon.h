@@ -20,7 +20,9 @@
 #ifndef ATHENA2_MODEL_COMPONENT_WEAPON_H_
 #define ATHENA2_MODEL_COMPONENT_WEAPON_H_
 
+#include <memory>
 #include <string>
+#include <type_traits>
 
 #include "dsl.h"
 #include "model/economy.h"
@@ -36,6 +38,53 @@ class Weapon : public util::Named {
     HANGAR,
   };
 
+  /**
+   * the numbers combat reads from a weapon; a component set keeps these for
+   * all its weapons in one dense table, apart from their names and metadata
+   */
+  struct Stats final {
+    float minDamage;
+    float maxDamage;
+    float minRange;
+    float maxRange;
+    float tracking;
+    float accuracy;
+    float cooldown;
+    float shieldDamageModifier;
+    float shieldSkipModifier;
+    float armourDamageModifier;
+    float armourSkipModifier;
+    float hullDamageModifier;
+    float sizeDamageModifier;
+    Type type;
+    /** tagged "explosive", so explosive damage modifiers apply */
+    bool explosive;
+    /** tagged "point-defence", so it can shoot projectiles and strike craft */
+    bool pointDefence;
+    union {
+      struct {
+      } regularWeapon;
+      struct {
+        float projectileSpeed;
+        float projectileEvasion;
+        float projectileRetargetRange;
+        float projectileHull;
+        float projectileArmour;
+      } projectileWeapon;
+      struct {
+        float unitsPerHangar;
+        float regenerationPerDay;
+        float strikeCraftRange;
+        float strikeCraftSpeed;
+        float strikeCraftEvasion;
+        float strikeCraftShield;
+        float strikeCraftArmour;
+        float strikeCraftHull;
+      } hangarWeapon;
+    } data;
+  };
+  static_assert(std::is_trivially_copyable_v<Stats>);
+
   static Weapon fromJson(nlohmann::json const &, EvalContext &);
 
   Weapon(Weapon const &) noexcept = delete;
@@ -46,73 +95,31 @@ class Weapon : public util::Named {
   Weapon &operator=(Weapon const &) noexcept = delete;
   Weapon &operator=(Weapon &&) noexcept = default;
 
+  /**
+   * move this weapon's stats into its slot in a table, and point the weapon
+   * at them there
+   */
+  void moveStatsTo(Stats &slot) noexcept;
+
+  /**
+   * the weapon's combat stats; once it's in a component set, these are in the
+   * set's table of weapon stats
+   */
+  Stats const *stats;
   std::string const size;
   std::string const tag;
   float const power;
-  float const minDamage;
-  float const maxDamage;
-  float const minRange;
-  float const maxRange;
-  float const tracking;
-  float const accuracy;
-  float const cooldown;
-  float const shieldDamageModifier;
-  float const shieldSkipModifier;
-  float const armourDamageModifier;
-  float const armourSkipModifier;
-  float const hullDamageModifier;
-  float const sizeDamageModifier;
-  Type type;
-  union {
-    struct {
-    } regularWeapon;
-    struct {
-      float const projectileSpeed;
-      float const projectileEvasion;
-      float const projectileRetargetRange;
-      float const projectileHull;
-      float const projectileArmour;
-    } projectileWeapon;
-    struct {
-      float const unitsPerHangar;
-      float const regenerationPerDay;
-      float const strikeCraftRange;
-      float const strikeCraftSpeed;
-      float const strikeCraftEvasion;
-      float const strikeCraftShield;
-      float const strikeCraftArmour;
-      float const strikeCraftHull;
-    } hangarWeapon;
-  } data;
   Cost const cost;
 
  private:
   Weapon(std::string const &name, std::string const &size,
-         std::string const &tag, float power, float minDamage, float maxDamage,
-         float minRange, float maxRange, float tracking, float accuracy,
-         float cooldown, float shieldDamageModifier, float shieldSkipModifier,
-         float armourDamageModifier, float armourSkipModifier,
-         float hullDamageModifier, float sizeDamageModifier,
+         std::string const &tag, float power, Stats const &stats,
          Cost const &cost) noexcept;
-  Weapon(std::string const &name, std::string const &size,
-         std::string const &tag, float power, float minDamage, float maxDamage,
-         float minRange, float maxRange, float tracking, float accuracy,
-         float cooldown, float shieldDamageModifier, float shieldSkipModifier,
-         float armourDamageModifier, float armourSkipModifier,
-         float hullDamageModifier, float sizeDamageModifier,
-         float projectileSpeed, float projectileEvasion,
-         float projectileRetargetRange, float projectileHull,
-         float projectileArmour, Cost const &cost) noexcept;
-  Weapon(std::string const &name, std::string const &size,
-         std::string const &tag, float power, float minDamage, float maxDamage,
-         float minRange, float maxRange, float tracking, float accuracy,
-         float cooldown, float shieldDamageModifier, float shieldSkipModifier,
-         float armourDamageModifier, float armourSkipModifier,
-         float hullDamageModifier, float sizeDamageModifier,
-         float unitsPerHangar, float regenerationPerDay, float strikeCraftRange,
-         float strikeCraftSpeed, float strikeCraftEvasion,
-         float strikeCraftShield, float strikeCraftArmour,
-         float strikeCraftHull, Cost const &cost) noexcept;
+
+  /**
+   * the stats, until they're moved into a table
+   */
+  std::unique_ptr<Stats const> ownStats;
 };
 }  // namespace athena2::model::component
 
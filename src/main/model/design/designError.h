@@ -0,0 +1,40 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ATHENA2_MODEL_DESIGN_DESIGNERROR_H_
+#define ATHENA2_MODEL_DESIGN_DESIGNERROR_H_
+
+namespace athena2::model::design {
+/**
+ * why a design is invalid, if it is
+ */
+enum class DesignError {
+  NONE,
+  WEAPON_SLOTS,
+  UTILITY_SLOTS,
+  SECTION_SLOTS,
+  REACTOR_SIZE,
+  SUBLIGHT_SIZE,
+  COMPUTER_SIZE,
+  AURA_SIZE,
+  POWER,
+};
+}  // namespace athena2::model::design
+
+#endif  // ATHENA2_MODEL_DESIGN_DESIGNERROR_H_
@@ -19,6 +19,10 @@
 
 #include "model/design/fleet.h"
 
+#include <algorithm>
+#include <memory>
+#include <string>
+
 #include "util/json.h"
 
 using namespace std;
@@ -29,21 +33,31 @@ using namespace athena2::util;
 namespace athena2::model::design {
 Fleet Fleet::fromJson(json const &data, ComponentSet const &components,
                       EvalContext &ctx) {
+  return fromJson(data, components, ShipRegistry(), ctx);
+}
+Fleet Fleet::fromJson(json const &data, ComponentSet const &components,
+                      ShipRegistry const &registry, EvalContext &ctx) {
   checkObject(data, ctx);
   string name = checkString(data, "name", ctx);
   json const &shipsData = checkArray(data, "ships", ctx);
   checkFields(data, {"name", "ships"}, ctx);
 
-  vector<pair<Ship, size_t>> ships;
+  vector<pair<shared_ptr<Ship const>, size_t>> ships;
   for (auto const &[key, val] : shipsData.items()) {
     auto _ = ctx.push(key);
     checkObject(val, ctx);
     size_t count = checkUnsignedInteger(val, "count", ctx);
     json const &ship = checkField(val, "ship", ctx);
     ships.emplace_back(
-        [&ship, &components, &ctx]() {
+        [&ship, &components, &registry, &ctx]() {
           auto _ = ctx.push("ship");
-          return Ship::fromJson(ship, components, ctx);
+          if (!ship.is_string())
+            return make_shared<Ship const>(
+                Ship::fromJson(ship, components, ctx));
+          string designName = ship.get<string>();
+          shared_ptr<Ship const> design = registry.get(designName);
+          if (!design) ctx.error("no such ship design '" + designName + "'");
+          return design;
         }(),
         count);
   }
@@ -51,13 +65,82 @@ Fleet Fleet::fromJson(json const &data, ComponentSet const &components,
   return Fleet(name, ships);
 }
 
-Fleet::Fleet(std::string const &name_,
-             vector<pair<Ship, size_t>> const &ships_) noexcept
+Fleet Fleet::canonical() const noexcept {
+  vector<pair<shared_ptr<Ship const>, size_t>> merged;
+  for (auto const &[ship, count] : ships) {
+    auto found =
+        find_if(merged.begin(), merged.end(),
+                [&ship](pair<shared_ptr<Ship const>, size_t> const &entry) {
+                  return entry.first == ship;
+                });
+    if (found != merged.end()) {
+      found->second += count;
+      continue;
+    }
+
+    // designs already in normal form (like registry ones) stay shared
+    Ship canonicalShip = ship->canonical();
+    shared_ptr<Ship const> canonicalPtr =
+        canonicalShip.sameDesign(*ship)
+            ? ship
+            : make_shared<Ship const>(move(canonicalShip));
+    found = find_if(
+        merged.begin(), merged.end(),
+        [&canonicalPtr](pair<shared_ptr<Ship const>, size_t> const &entry) {
+          return entry.first->sameDesign(*canonicalPtr);
+        });
+    if (found != merged.end())
+      found->second += count;
+    else
+      merged.emplace_back(canonicalPtr, count);
+  }
+
+  // sort by the names of the components that make up each design; ships are
+  // in normal form here, so their sections are already in a fixed order
+  auto designKey = [](Ship const &ship) {
+    string key = ship.hull->name + '\0' + ship.reactor->name + '\0' +
+                 ship.ftl->name + '\0' + ship.sublight->name + '\0' +
+                 ship.sensor->name + '\0' + ship.computer->name + '\0' +
+                 (ship.aura ? ship.aura->name : "");
+    for (Section const &section : ship.sections) {
+      key += '\1' + section.section->name;
+      for (auto weapon : section.weapons) key += '\0' + weapon->name;
+      key += '\1';
+      for (auto utility : section.utilities) key += '\0' + utility->name;
+      key += '\1';
+      for (auto auxiliary : section.auxiliaries) key += '\0' + auxiliary->name;
+    }
+    return key;
+  };
+  vector<pair<string, size_t>> keyed;
+  for (size_t idx = 0; idx < merged.size(); ++idx)
+    keyed.emplace_back(designKey(*merged[idx].first), idx);
+  sort(keyed.begin(), keyed.end());
+
+  vector<pair<shared_ptr<Ship const>, size_t>> sorted;
+  for (auto const &[key, idx] : keyed)
+    if (merged[idx].second > 0) sorted.push_back(merged[idx]);
+  return Fleet(name, sorted);
+}
+bool Fleet::sameDesign(Fleet const &other) const noexcept {
+  return equal(
+      ships.begin(), ships.end(), other.ships.begin(), other.ships.end(),
+      [](pair<shared_ptr<Ship const>, size_t> const &lhs,
+         pair<shared_ptr<Ship const>, size_t> const &rhs) {
+        return lhs.second == rhs.second &&
+               (lhs.first == rhs.first || lhs.first->sameDesign(*rhs.first));
+      });
+}
+
+Fleet::Fleet(
+    std::string const &name_,
+    vector<pair<shared_ptr<Ship const>, size_t>> const &ships_) noexcept
     : Named(name_), ships(ships_), cost(computeCost()) {}
 float Fleet::computeCost() const noexcept {
   return accumulate(ships.begin(), ships.end(), 0.f,
-                    [](float rsf, pair<Ship, size_t> const &element) {
-                      return rsf + element.first.cost * element.second;
+                    [](float rsf,
+                       pair<shared_ptr<Ship const>, size_t> const &element) {
+                      return rsf + element.first->cost * element.second;
                     });
 }
 }  // namespace athena2::model::design
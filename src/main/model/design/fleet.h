@@ -20,6 +20,7 @@
 #ifndef ATHENA2_MODEL_DESIGN_FLEET_H_
 #define ATHENA2_MODEL_DESIGN_FLEET_H_
 
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -27,6 +28,7 @@
 #include "dsl.h"
 #include "model/component/componentSet.h"
 #include "model/design/ship.h"
+#include "model/design/shipRegistry.h"
 #include "nlohmann/json.hpp"
 #include "util/named.h"
 
@@ -35,6 +37,12 @@ class Fleet final : public util::Named {
  public:
   static Fleet fromJson(nlohmann::json const &, component::ComponentSet const &,
                         EvalContext &ctx);
+  /**
+   * as above, but a ship can also be given as the name of a design in the
+   * registry, which the fleet then shares
+   */
+  static Fleet fromJson(nlohmann::json const &, component::ComponentSet const &,
+                        ShipRegistry const &, EvalContext &ctx);
 
   Fleet(Fleet const &) noexcept = default;
   Fleet(Fleet &&) noexcept = default;
@@ -44,12 +52,25 @@ class Fleet final : public util::Named {
   Fleet &operator=(Fleet const &) noexcept = default;
   Fleet &operator=(Fleet &&) noexcept = default;
 
-  std::vector<std::pair<Ship, size_t>> const ships;
+  /**
+   * this fleet with every ship in normal form, ships of the same design merged
+   * into one entry, and entries sorted
+   */
+  Fleet canonical() const noexcept;
+  /**
+   * true if both fleets have the same ship designs in the same order and
+   * numbers; compare canonical fleets to ignore order
+   */
+  bool sameDesign(Fleet const &) const noexcept;
+
+  /** designs are shared with the registry and with copies of this fleet */
+  std::vector<std::pair<std::shared_ptr<Ship const>, size_t>> const ships;
   float const cost;
 
  private:
   Fleet(std::string const &name,
-        std::vector<std::pair<Ship, size_t>> const &ships) noexcept;
+        std::vector<std::pair<std::shared_ptr<Ship const>, size_t>> const
+            &ships) noexcept;
   float computeCost() const noexcept;
 };
 }  // namespace athena2::model::design
@@ -0,0 +1,204 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/design/genome.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <string_view>
+
+#include "util/hash.h"
+
+using namespace std;
+using namespace athena2::util;
+using namespace athena2::model::component;
+
+namespace athena2::model::design {
+namespace {
+/**
+ * bump whenever the genome layout or file format changes
+ */
+constexpr uint64_t GENOME_FORMAT = 1;
+
+/**
+ * header fields: format, words per genome, component fingerprint, count
+ */
+constexpr size_t HEADER_FIELDS = 4;
+
+template <typename T>
+vector<reference_wrapper<T const>> dereferenced(
+    vector<T const *> const &components) {
+  vector<reference_wrapper<T const>> result;
+  for (T const *component : components) result.push_back(*component);
+  return result;
+}
+}  // namespace
+
+optional<Genome> Genome::encode(Ship const &ship,
+                                ComponentSet const &components) noexcept {
+  if (ship.sections.size() > MAX_SECTIONS) return nullopt;
+
+  Genome genome;
+  genome.words[0] = components.idOf(*ship.hull);
+  genome.words[1] = components.idOf(*ship.reactor);
+  genome.words[2] = components.idOf(*ship.ftl);
+  genome.words[3] = components.idOf(*ship.sublight);
+  genome.words[4] = components.idOf(*ship.sensor);
+  genome.words[5] = components.idOf(*ship.computer);
+  genome.words[6] = ship.aura ? components.idOf(*ship.aura) : NONE;
+  for (size_t idx = 0; idx < ship.sections.size(); ++idx) {
+    Section const &section = ship.sections[idx];
+    if (section.weapons.size() > MAX_WEAPONS ||
+        section.utilities.size() + section.auxiliaries.size() > MAX_UTILITIES)
+      return nullopt;
+
+    auto block = genome.words.begin() + CORE_WORDS + idx * SECTION_WORDS;
+    block[0] = components.idOf(*section.section);
+    transform(section.weapons.begin(), section.weapons.end(), block + 1,
+              [&components](Weapon const *weapon) {
+                return components.idOf(*weapon);
+              });
+    auto utilities = transform(section.utilities.begin(),
+                               section.utilities.end(), block + 1 + MAX_WEAPONS,
+                               [&components](Utility const *utility) {
+                                 return components.idOf(*utility);
+                               });
+    transform(section.auxiliaries.begin(), section.auxiliaries.end(),
+              utilities, [&components](Auxiliary const *auxiliary) {
+                return static_cast<uint16_t>(components.idOf(*auxiliary) |
+                                             AUXILIARY);
+              });
+  }
+  return genome;
+}
+
+Genome::Genome() noexcept : words() { words.fill(NONE); }
+
+optional<Ship> Genome::decode(string const &name,
+                              ComponentSet const &components) const noexcept {
+  Hull const *hull = components.getHull(words[0]);
+  Reactor const *reactor = components.getReactor(words[1]);
+  FTL const *ftl = components.getFTL(words[2]);
+  Sublight const *sublight = components.getSublight(words[3]);
+  Sensor const *sensor = components.getSensor(words[4]);
+  Computer const *computer = components.getComputer(words[5]);
+  Aura const *aura = words[6] == NONE ? nullptr : components.getAura(words[6]);
+  if (!hull || !reactor || !ftl || !sublight || !sensor || !computer ||
+      (words[6] != NONE && !aura))
+    return nullopt;
+
+  vector<Section> sections;
+  for (size_t idx = 0; idx < MAX_SECTIONS; ++idx) {
+    auto block = words.begin() + CORE_WORDS + idx * SECTION_WORDS;
+    if (block[0] == NONE) continue;
+    component::Section const *section = components.getSection(block[0]);
+    if (!section) return nullopt;
+
+    vector<Weapon const *> weapons;
+    for (auto it = block + 1; it != block + 1 + MAX_WEAPONS; ++it) {
+      if (*it == NONE) continue;
+      Weapon const *weapon = components.getWeapon(*it);
+      if (!weapon) return nullopt;
+      weapons.push_back(weapon);
+    }
+    vector<Utility const *> utilities;
+    vector<Auxiliary const *> auxiliaries;
+    for (auto it = block + 1 + MAX_WEAPONS; it != block + SECTION_WORDS; ++it) {
+      if (*it == NONE) {
+        continue;
+      } else if (*it & AUXILIARY) {
+        Auxiliary const *auxiliary = components.getAuxiliary(
+            static_cast<ComponentId>(*it & ~AUXILIARY));
+        if (!auxiliary) return nullopt;
+        auxiliaries.push_back(auxiliary);
+      } else {
+        Utility const *utility = components.getUtility(*it);
+        if (!utility) return nullopt;
+        utilities.push_back(utility);
+      }
+    }
+
+    if (Section::validate(*section, weapons, utilities, auxiliaries) !=
+        DesignError::NONE)
+      return nullopt;
+    // validated, so this can't throw
+    sections.push_back(Section(*section, dereferenced(weapons),
+                               dereferenced(utilities),
+                               dereferenced(auxiliaries)));
+  }
+
+  if (Ship::validate(*hull, *reactor, *ftl, *sublight, *sensor, *computer,
+                     aura, sections) != DesignError::NONE)
+    return nullopt;
+  // validated, so this can't throw
+  return Ship(Ship::className(name, *hull), *hull, *reactor, *ftl, *sublight,
+              *sensor, *computer, aura, sections);
+}
+
+uint64_t Genome::hash() const noexcept {
+  return hashBytes(string_view(reinterpret_cast<char const *>(words.data()),
+                               sizeof(words)));
+}
+
+vector<Genome> readGenomes(string const &filename,
+                           ComponentSet const &components, EvalContext &ctx) {
+  auto _ = ctx.push(filename);
+
+  ifstream in(filename, ios::binary);
+  if (!in) ctx.error("could not open file");
+
+  uint64_t header[HEADER_FIELDS];
+  if (!in.read(reinterpret_cast<char *>(header), sizeof(header)))
+    ctx.error("not a genome file");
+  if (header[0] != GENOME_FORMAT || header[1] != Genome::WORDS)
+    ctx.error("genome file has an unsupported format");
+  components.loadAll();
+  if (header[2] != components.fingerprint())
+    ctx.error("genome file was written with different components");
+
+  vector<Genome> genomes;
+  for (uint64_t idx = 0; idx < header[3]; ++idx) {
+    Genome genome;
+    if (!in.read(reinterpret_cast<char *>(genome.words.data()),
+                 sizeof(genome.words)))
+      ctx.error("genome file is truncated");
+    genomes.push_back(genome);
+  }
+  return genomes;
+}
+
+void writeGenomes(string const &filename, vector<Genome> const &genomes,
+                  ComponentSet const &components, EvalContext &ctx) {
+  auto _ = ctx.push(filename);
+
+  components.loadAll();
+  ofstream out(filename, ios::binary | ios::trunc);
+  if (!out) ctx.error("could not open file");
+
+  uint64_t header[HEADER_FIELDS] = {GENOME_FORMAT, Genome::WORDS,
+                                    components.fingerprint(), genomes.size()};
+  out.write(reinterpret_cast<char const *>(header), sizeof(header));
+  for (Genome const &genome : genomes)
+    out.write(reinterpret_cast<char const *>(genome.words.data()),
+              sizeof(genome.words));
+  out.flush();
+  if (!out) ctx.error("could not write file");
+}
+}  // namespace athena2::model::design
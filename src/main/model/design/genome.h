@@ -0,0 +1,117 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ATHENA2_MODEL_DESIGN_GENOME_H_
+#define ATHENA2_MODEL_DESIGN_GENOME_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "dsl.h"
+#include "model/component/componentSet.h"
+#include "model/design/ship.h"
+
+namespace athena2::model::design {
+/**
+ * fixed-size encoding of a ship design as component ids
+ *
+ * the layout is the hull, reactor, ftl, sublight, sensor, computer, and aura
+ * ids, followed by MAX_SECTIONS section blocks. Each section block is the
+ * section id, MAX_WEAPONS weapon ids, and MAX_UTILITIES utility slot ids.
+ * Utility slots hold utilities, then auxiliaries tagged with AUXILIARY. Unused
+ * entries are NONE
+ *
+ * ids are only meaningful alongside the component set that assigned them. A
+ * set gives out ids in the order its components are added or deferred, so
+ * sets loaded from the same files agree on them however lazily they load
+ */
+class Genome final {
+ public:
+  static constexpr std::size_t MAX_SECTIONS = 3;
+  static constexpr std::size_t MAX_WEAPONS = 25;
+  static constexpr std::size_t MAX_UTILITIES = 25;
+
+  static constexpr std::uint16_t NONE = 0xffff;
+  static constexpr std::uint16_t AUXILIARY = 0x8000;
+
+  static constexpr std::size_t CORE_WORDS = 7;
+  static constexpr std::size_t SECTION_WORDS = 1 + MAX_WEAPONS + MAX_UTILITIES;
+  static constexpr std::size_t WORDS =
+      CORE_WORDS + MAX_SECTIONS * SECTION_WORDS;
+
+  /**
+   * encode a design; nothing if it has too many sections or slots to fit
+   */
+  static std::optional<Genome> encode(
+      Ship const &, component::ComponentSet const &) noexcept;
+
+  Genome() noexcept;
+  Genome(Genome const &) noexcept = default;
+  Genome(Genome &&) noexcept = default;
+
+  ~Genome() noexcept = default;
+
+  Genome &operator=(Genome const &) noexcept = default;
+  Genome &operator=(Genome &&) noexcept = default;
+
+  bool operator==(Genome const &) const noexcept = default;
+
+  /**
+   * build the design; nothing if an id is out of range or the design is
+   * invalid
+   */
+  std::optional<Ship> decode(std::string const &name,
+                             component::ComponentSet const &) const noexcept;
+
+  std::uint64_t hash() const noexcept;
+
+  std::array<std::uint16_t, WORDS> words;
+};
+
+/**
+ * read a population of genomes
+ *
+ * the file must have been written with the same components; this loads any
+ * deferred ones, so it can tell
+ */
+std::vector<Genome> readGenomes(std::string const &filename,
+                                component::ComponentSet const &,
+                                EvalContext &ctx);
+/**
+ * write a population of genomes, replacing the file; this loads any deferred
+ * components, so the file records the whole set
+ */
+void writeGenomes(std::string const &filename, std::vector<Genome> const &,
+                  component::ComponentSet const &, EvalContext &ctx);
+}  // namespace athena2::model::design
+
+template <>
+struct std::hash<athena2::model::design::Genome> {
+  std::size_t operator()(
+      athena2::model::design::Genome const &genome) const noexcept {
+    return genome.hash();
+  }
+};
+
+#endif  // ATHENA2_MODEL_DESIGN_GENOME_H_
@@ -31,6 +31,19 @@ using namespace athena2::model::component;
 using namespace nlohmann;
 
 namespace athena2::model::design {
+namespace {
+/**
+ * sizes that don't have a slot left for them
+ */
+string unmatched(string sizes, string const &slots) {
+  sort(sizes.begin(), sizes.end());
+  string result;
+  set_difference(sizes.begin(), sizes.end(), slots.begin(), slots.end(),
+                 back_inserter(result));
+  return result;
+}
+}  // namespace
+
 Section Section::fromJson(json const &data, ComponentSet const &components,
                           EvalContext &ctx) {
   checkObject(data, ctx);
@@ -87,6 +100,45 @@ Section Section::fromJson(json const &data, ComponentSet const &components,
   }
 }
 
+DesignError Section::validate(
+    component::Section const &section, vector<Weapon const *> const &weapons,
+    vector<Utility const *> const &utilities,
+    vector<Auxiliary const *> const &auxiliaries) noexcept {
+  // counts must stay within SlotSet's; no section has that many slots
+  if (weapons.size() > SlotSet::MAX_COUNT) return DesignError::WEAPON_SLOTS;
+  SlotSet weaponSizes;
+  for (Weapon const *weapon : weapons) weaponSizes.add(weapon->size[0]);
+  if (!weaponSizes.fitsIn(section.weaponSlotSet))
+    return DesignError::WEAPON_SLOTS;
+
+  if (utilities.size() + auxiliaries.size() > SlotSet::MAX_COUNT)
+    return DesignError::UTILITY_SLOTS;
+  SlotSet utilitySizes;
+  for (Utility const *utility : utilities) utilitySizes.add(utility->size[0]);
+  for (Auxiliary const *auxiliary : auxiliaries)
+    utilitySizes.add(auxiliary->size[0]);
+  if (!utilitySizes.fitsIn(section.utilitySlotSet))
+    return DesignError::UTILITY_SLOTS;
+
+  return DesignError::NONE;
+}
+Section Section::canonical() const noexcept {
+  auto sorted = []<typename T>(vector<T const *> const &components) {
+    vector<reference_wrapper<T const>> result;
+    for (T const *component : components) result.push_back(*component);
+    stable_sort(result.begin(), result.end(),
+                [](T const &lhs, T const &rhs) { return lhs.name < rhs.name; });
+    return result;
+  };
+  // a permutation of a valid design is valid, so this can't throw
+  return Section(*section, sorted(weapons), sorted(utilities),
+                 sorted(auxiliaries));
+}
+bool Section::sameDesign(Section const &other) const noexcept {
+  return section == other.section && weapons == other.weapons &&
+         utilities == other.utilities && auxiliaries == other.auxiliaries;
+}
+
 Section::Section(
     component::Section const &section_,
     vector<reference_wrapper<component::Weapon const>> const &weapons_,
@@ -101,34 +153,30 @@ Section::Section(
             back_inserter(auxiliaries),
             [](component::Auxiliary const &auxiliary) { return &auxiliary; });
 
-  string weaponSizes = accumulate(weapons.begin(), weapons.end(), ""s,
-                                  [](string const &rsf, Weapon const *weapon) {
-                                    return rsf + weapon->size;
-                                  });
-  sort(weaponSizes.begin(), weaponSizes.end());
-  string unmatched;
-  set_difference(weaponSizes.begin(), weaponSizes.end(),
-                 section->weaponSlots.begin(), section->weaponSlots.end(),
-                 back_inserter(unmatched));
-  if (!unmatched.empty())
-    throw DesignException("weapons requiring missing slots (" + unmatched +
-                          ") found in section design");
-
-  string utilitySizes =
-      accumulate(utilities.begin(), utilities.end(), ""s,
-                 [](string const &rsf, Utility const *utility) {
-                   return rsf + utility->size;
-                 }) +
-      accumulate(auxiliaries.begin(), auxiliaries.end(), ""s,
-                 [](string const &rsf, Auxiliary const *auxiliary) {
-                   return rsf + auxiliary->size;
-                 });
-  sort(utilitySizes.begin(), utilitySizes.end());
-  set_difference(utilitySizes.begin(), utilitySizes.end(),
-                 section->utilitySlots.begin(), section->utilitySlots.end(),
-                 back_inserter(unmatched));
-  if (!unmatched.empty())
-    throw DesignException("utility components requiring missing slots (" +
-                          unmatched + ") found in section design");
+  // only spell out what went wrong once validation has failed
+  DesignError error = validate(*section, weapons, utilities, auxiliaries);
+  if (error == DesignError::WEAPON_SLOTS)
+    throw DesignException(
+        "weapons requiring missing slots (" +
+        unmatched(accumulate(weapons.begin(), weapons.end(), ""s,
+                             [](string const &rsf, Weapon const *weapon) {
+                               return rsf + weapon->size;
+                             }),
+                  section->weaponSlots) +
+        ") found in section design");
+  if (error == DesignError::UTILITY_SLOTS)
+    throw DesignException(
+        "utility components requiring missing slots (" +
+        unmatched(accumulate(utilities.begin(), utilities.end(), ""s,
+                             [](string const &rsf, Utility const *utility) {
+                               return rsf + utility->size;
+                             }) +
+                      accumulate(auxiliaries.begin(), auxiliaries.end(), ""s,
+                                 [](string const &rsf,
+                                    Auxiliary const *auxiliary) {
+                                   return rsf + auxiliary->size;
+                                 }),
+                  section->utilitySlots) +
+        ") found in section design");
 }
 }  // namespace athena2::model::design
@@ -29,6 +29,7 @@
 #include "model/component/section.h"
 #include "model/component/utility.h"
 #include "model/component/weapon.h"
+#include "model/design/designError.h"
 #include "nlohmann/json.hpp"
 
 namespace athena2::model::design {
@@ -36,6 +37,14 @@ class Section final {
  public:
   static Section fromJson(nlohmann::json const &,
                           component::ComponentSet const &, EvalContext &ctx);
+  /**
+   * check that a section design is valid without building it
+   */
+  static DesignError validate(
+      component::Section const &,
+      std::vector<component::Weapon const *> const &,
+      std::vector<component::Utility const *> const &,
+      std::vector<component::Auxiliary const *> const &) noexcept;
 
   Section(Section const &) noexcept = default;
   Section(Section &&) noexcept = default;
@@ -45,6 +54,16 @@ class Section final {
   Section &operator=(Section const &) noexcept = default;
   Section &operator=(Section &&) noexcept = default;
 
+  /**
+   * this section with its slot contents sorted into a normal form; sections
+   * that differ only in the order of their contents have the same normal form
+   */
+  Section canonical() const noexcept;
+  /**
+   * true if both sections hold the same components in the same order
+   */
+  bool sameDesign(Section const &) const noexcept;
+
   component::Section const *section;
   std::vector<component::Weapon const *> weapons;
   std::vector<component::Utility const *> utilities;
@@ -60,6 +79,8 @@ class Section final {
       std::vector<std::reference_wrapper<component::Weapon const>> const &,
       std::vector<std::reference_wrapper<component::Utility const>> const &,
       std::vector<std::reference_wrapper<component::Auxiliary const>> const &);
+
+  friend class Genome;
 };
 }  // namespace athena2::model::design
 
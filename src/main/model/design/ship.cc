@@ -20,6 +20,8 @@
 #include "model/design/ship.h"
 
 #include <algorithm>
+#include <string>
+#include <utility>
 
 #include "util/json.h"
 
@@ -29,6 +31,52 @@ using namespace athena2::model::component;
 using namespace nlohmann;
 
 namespace athena2::model::design {
+namespace {
+/**
+ * power left over once every component is powered
+ */
+float totalPower(Reactor const &reactor, FTL const &ftl,
+                 Sublight const &sublight, Sensor const &sensor,
+                 Computer const &computer,
+                 vector<Section> const &sections) noexcept {
+  return reactor.power + ftl.power + sublight.power + sensor.power +
+         computer.power +
+         accumulate(sections.begin(), sections.end(), 0.0f,
+                    [](float acc, Section const &section) {
+                      return acc +
+                             accumulate(section.weapons.begin(),
+                                        section.weapons.end(), 0.f,
+                                        [](float rsf, Weapon const *weapon) {
+                                          return rsf + weapon->power;
+                                        }) +
+                             accumulate(section.utilities.begin(),
+                                        section.utilities.end(), 0.f,
+                                        [](float rsf, Utility const *utility) {
+                                          return rsf + utility->power;
+                                        }) +
+                             accumulate(section.auxiliaries.begin(),
+                                        section.auxiliaries.end(), 0.f,
+                                        [](float rsf,
+                                           Auxiliary const *auxiliary) {
+                                          return rsf + auxiliary->power;
+                                        });
+                    });
+}
+/**
+ * sorts sections in normal form by size, then by name, then by what's fitted
+ * in them
+ */
+string sectionKey(Section const &section) noexcept {
+  string key = section.section->size + '\0' + section.section->name;
+  for (auto weapon : section.weapons) key += '\0' + weapon->name;
+  key += '\1';
+  for (auto utility : section.utilities) key += '\0' + utility->name;
+  key += '\1';
+  for (auto auxiliary : section.auxiliaries) key += '\0' + auxiliary->name;
+  return key;
+}
+}  // namespace
+
 Ship Ship::fromJson(json const &data, ComponentSet const &components,
                     EvalContext &ctx) {
   checkObject(data, ctx);
@@ -101,17 +149,79 @@ Ship Ship::fromJson(json const &data, ComponentSet const &components,
   }
 
   try {
-    return Ship(name, hull, reactor, ftl, sublight, sensor, computer, aura,
-                sections);
+    return Ship(className(name, hull), hull, reactor, ftl, sublight, sensor,
+                computer, aura, sections);
   } catch (DesignException const &e) {
     ctx.error("invalid ship design"s + e.what());
   }
 }
+DesignError Ship::validate(Hull const &hull, Reactor const &reactor,
+                           FTL const &ftl, Sublight const &sublight,
+                           Sensor const &sensor, Computer const &computer,
+                           Aura const *aura,
+                           vector<Section> const &sections) noexcept {
+  // sections need a slot of their size each; counts must stay within
+  // SlotSet's, and no ship has that many sections
+  if (sections.size() > SlotSet::MAX_COUNT) return DesignError::SECTION_SLOTS;
+  SlotSet sectionSizes;
+  for (Section const &section : sections)
+    sectionSizes.addLane(section.section->sizeLane);
+  if (!sectionSizes.fitsIn(hull.sectionSlotSet))
+    return DesignError::SECTION_SLOTS;
+
+  if ((reactor.sizeMask & hull.coreSizeBit) == 0)
+    return DesignError::REACTOR_SIZE;
+
+  if ((sublight.sizeMask & hull.coreSizeBit) == 0)
+    return DesignError::SUBLIGHT_SIZE;
+
+  if ((computer.sizeMask & hull.coreSizeBit) == 0)
+    return DesignError::COMPUTER_SIZE;
+
+  if (aura && aura->size != hull.coreSize) return DesignError::AURA_SIZE;
+
+  if (totalPower(reactor, ftl, sublight, sensor, computer, sections) < 0)
+    return DesignError::POWER;
+
+  return DesignError::NONE;
+}
+Ship Ship::canonical() const noexcept {
+  vector<pair<string, Section>> keyed;
+  for (Section const &section : sections) {
+    Section canonicalSection = section.canonical();
+    keyed.emplace_back(sectionKey(canonicalSection), canonicalSection);
+  }
+  stable_sort(keyed.begin(), keyed.end(),
+              [](pair<string, Section> const &lhs,
+                 pair<string, Section> const &rhs) {
+                return lhs.first < rhs.first;
+              });
+  vector<Section> canonicalSections;
+  for (auto const &[key, section] : keyed) canonicalSections.push_back(section);
+  // a permutation of a valid design is valid, so this can't throw
+  return Ship(name, *hull, *reactor, *ftl, *sublight, *sensor, *computer,
+              aura, canonicalSections);
+}
+bool Ship::sameDesign(Ship const &other) const noexcept {
+  return hull == other.hull && reactor == other.reactor && ftl == other.ftl &&
+         sublight == other.sublight && sensor == other.sensor &&
+         computer == other.computer && aura == other.aura &&
+         equal(sections.begin(), sections.end(), other.sections.begin(),
+               other.sections.end(),
+               [](Section const &lhs, Section const &rhs) {
+                 return lhs.sameDesign(rhs);
+               });
+}
+
+string Ship::className(string const &name, Hull const &hull) noexcept {
+  return name + "-class " + hull.name;
+}
+
 Ship::Ship(string const &name_, Hull const &hull_, Reactor const &reactor_,
            FTL const &ftl_, Sublight const &sublight_, Sensor const &sensor_,
            Computer const &computer_, component::Aura const *aura_,
            vector<Section> const &sections_)
-    : Named(name_ + "-class " + hull_.name),
+    : Named(name_),
       hull(&hull_),
       reactor(&reactor_),
       ftl(&ftl_),
@@ -120,28 +230,8 @@ Ship::Ship(string const &name_, Hull const &hull_, Reactor const &reactor_,
       computer(&computer_),
       aura(aura_),
       sections(sections_),
-      power(reactor->power + ftl->power + sublight->power + sensor->power +
-            computer->power +
-            accumulate(
-                sections.begin(), sections.end(), 0.0f,
-                [](float acc, Section const &section) {
-                  return acc +
-                         accumulate(section.weapons.begin(),
-                                    section.weapons.end(), 0.f,
-                                    [](float rsf, Weapon const *weapon) {
-                                      return rsf + weapon->power;
-                                    }) +
-                         accumulate(section.utilities.begin(),
-                                    section.utilities.end(), 0.f,
-                                    [](float rsf, Utility const *utility) {
-                                      return rsf + utility->power;
-                                    }) +
-                         accumulate(section.auxiliaries.begin(),
-                                    section.auxiliaries.end(), 0.f,
-                                    [](float rsf, Auxiliary const *auxiliary) {
-                                      return rsf + auxiliary->power;
-                                    });
-                })),
+      power(totalPower(*reactor, *ftl, *sublight, *sensor, *computer,
+                       sections)),
       cost(hull->includeComponentCost
                ? hull->cost + reactor->cost + ftl->cost + sublight->cost +
                      sensor->cost + computer->cost +
@@ -344,8 +434,8 @@ Ship::Ship(string const &name_, Hull const &hull_, Reactor const &reactor_,
             vector<float> averageRanges;
             for (Section const &section : sections_) {
               for (Weapon const *weapon : section.weapons) {
-                averageRanges.push_back((weapon->minRange + weapon->maxRange) /
-                                        2.f);
+                averageRanges.push_back(
+                    (weapon->stats->minRange + weapon->stats->maxRange) / 2.f);
               }
             }
             if (averageRanges.empty()) {
@@ -359,8 +449,8 @@ Ship::Ship(string const &name_, Hull const &hull_, Reactor const &reactor_,
             vector<float> averageRanges;
             for (Section const &section : sections_) {
               for (Weapon const *weapon : section.weapons) {
-                averageRanges.push_back((weapon->minRange + weapon->maxRange) /
-                                        2.f);
+                averageRanges.push_back(
+                    (weapon->stats->minRange + weapon->stats->maxRange) / 2.f);
               }
             }
             if (averageRanges.empty()) {
@@ -374,8 +464,8 @@ Ship::Ship(string const &name_, Hull const &hull_, Reactor const &reactor_,
             vector<float> averageRanges;
             for (Section const &section : sections_) {
               for (Weapon const *weapon : section.weapons) {
-                averageRanges.push_back((weapon->minRange + weapon->maxRange) /
-                                        2.f);
+                averageRanges.push_back(
+                    (weapon->stats->minRange + weapon->stats->maxRange) / 2.f);
               }
             }
             if (averageRanges.empty()) {
@@ -389,33 +479,42 @@ Ship::Ship(string const &name_, Hull const &hull_, Reactor const &reactor_,
           }
         }
       }()) {
-  vector<string> sectionSizes;
-  transform(sections.begin(), sections.end(), back_inserter(sectionSizes),
-            [](Section const &section) { return section.section->size; });
-  sort(sectionSizes.begin(), sectionSizes.end());
-  vector<string> unmatched;
-  set_difference(sectionSizes.begin(), sectionSizes.end(),
-                 hull->sectionSizes.begin(), hull->sectionSizes.end(),
-                 back_inserter(unmatched));
-  if (!unmatched.empty())
-    throw DesignException(to_string(unmatched.size()) +
-                          "sections requriring missing slots");
-
-  if (find(reactor->sizes.begin(), reactor->sizes.end(), hull->coreSize) ==
-      reactor->sizes.end())
-    throw DesignException("reactor does not fit hull");
-
-  if (find(sublight->sizes.begin(), sublight->sizes.end(), hull->coreSize) ==
-      sublight->sizes.end())
-    throw DesignException("sublight does not fit hull");
-
-  if (find(computer->sizes.begin(), computer->sizes.end(), hull->coreSize) ==
-      computer->sizes.end())
-    throw DesignException("computer does not fit hull");
-
-  if (aura && aura->size != hull->coreSize)
-    throw DesignException("aura does not fit hull");
-
-  if (power < 0) throw DesignException("insufficient power");
+  switch (validate(*hull, *reactor, *ftl, *sublight, *sensor, *computer, aura,
+                   sections)) {
+    case DesignError::NONE: {
+      return;
+    }
+    case DesignError::SECTION_SLOTS: {
+      vector<string> sectionSizes;
+      transform(sections.begin(), sections.end(), back_inserter(sectionSizes),
+                [](Section const &section) { return section.section->size; });
+      sort(sectionSizes.begin(), sectionSizes.end());
+      vector<string> unmatched;
+      set_difference(sectionSizes.begin(), sectionSizes.end(),
+                     hull->sectionSizes.begin(), hull->sectionSizes.end(),
+                     back_inserter(unmatched));
+      throw DesignException(to_string(unmatched.size()) +
+                            "sections requriring missing slots");
+    }
+    case DesignError::REACTOR_SIZE: {
+      throw DesignException("reactor does not fit hull");
+    }
+    case DesignError::SUBLIGHT_SIZE: {
+      throw DesignException("sublight does not fit hull");
+    }
+    case DesignError::COMPUTER_SIZE: {
+      throw DesignException("computer does not fit hull");
+    }
+    case DesignError::AURA_SIZE: {
+      throw DesignException("aura does not fit hull");
+    }
+    case DesignError::POWER: {
+      throw DesignException("insufficient power");
+    }
+    case DesignError::WEAPON_SLOTS:
+    case DesignError::UTILITY_SLOTS: {
+      abort();  // sections are checked when they're built
+    }
+  }
 }
 }  // namespace athena2::model::design
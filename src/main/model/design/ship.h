@@ -34,6 +34,7 @@
 #include "model/component/reactor.h"
 #include "model/component/sensor.h"
 #include "model/component/sublight.h"
+#include "model/design/designError.h"
 #include "model/design/section.h"
 #include "nlohmann/json.hpp"
 #include "util/named.h"
@@ -43,6 +44,18 @@ class Ship final : public util::Named {
  public:
   static Ship fromJson(nlohmann::json const &, component::ComponentSet const &,
                        EvalContext &);
+  /**
+   * check that a ship design is valid without building it; sections are
+   * assumed valid
+   */
+  static DesignError validate(component::Hull const &,
+                              component::Reactor const &,
+                              component::FTL const &,
+                              component::Sublight const &,
+                              component::Sensor const &,
+                              component::Computer const &,
+                              component::Aura const *,
+                              std::vector<Section> const &) noexcept;
 
   Ship(Ship const &) noexcept = default;
   Ship(Ship &&) noexcept = default;
@@ -52,6 +65,17 @@ class Ship final : public util::Named {
   Ship &operator=(Ship const &) noexcept = default;
   Ship &operator=(Ship &&) noexcept = default;
 
+  /**
+   * this ship with each section's contents in normal form, and its sections
+   * sorted by size, then name, then contents
+   */
+  Ship canonical() const noexcept;
+  /**
+   * true if both ships are built from the same components in the same order,
+   * whatever they're called
+   */
+  bool sameDesign(Ship const &) const noexcept;
+
   // ship design
   component::Hull const *hull;
   component::Reactor const *reactor;
@@ -92,12 +116,22 @@ class Ship final : public util::Named {
 
  private:
   /**
+   * name of a ship with the given design name built on the given hull
+   */
+  static std::string className(std::string const &,
+                               component::Hull const &) noexcept;
+
+  /**
+   * takes the full name, as from className
+   *
    * @throws DesignException if ship design is invalid (e.g. not enough power)
    */
   Ship(std::string const &, component::Hull const &, component::Reactor const &,
        component::FTL const &, component::Sublight const &,
        component::Sensor const &, component::Computer const &,
        component::Aura const *, std::vector<Section> const &);
+
+  friend class Genome;
 };
 }  // namespace athena2::model::design
 
@@ -0,0 +1,57 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/design/shipRegistry.h"
+
+#include "util/json.h"
+
+using namespace std;
+using namespace athena2::model::component;
+using namespace nlohmann;
+using namespace athena2::util;
+
+namespace athena2::model::design {
+ShipRegistry ShipRegistry::fromJson(json const &data,
+                                    ComponentSet const &components,
+                                    EvalContext &ctx) {
+  checkType(data, &json::is_array, "array", ctx);
+  ShipRegistry registry;
+  for (auto const &[key, val] : data.items()) {
+    auto _ = ctx.push(key);
+    checkObject(val, ctx);
+    string name = checkString(val, "name", ctx);
+    registry.add(name, Ship::fromJson(val, components, ctx), ctx);
+  }
+  return registry;
+}
+
+ShipRegistry &ShipRegistry::add(string const &name, Ship const &ship,
+                                EvalContext &ctx) {
+  if (designs.contains(name)) ctx.error("duplicate ship design " + name);
+  designs.emplace(name, make_shared<Ship const>(ship.canonical()));
+  return *this;
+}
+
+shared_ptr<Ship const> ShipRegistry::get(string const &name) const noexcept {
+  auto found = designs.find(name);
+  return found != designs.end() ? found->second : nullptr;
+}
+
+size_t ShipRegistry::size() const noexcept { return designs.size(); }
+}  // namespace athena2::model::design
@@ -0,0 +1,78 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ATHENA2_MODEL_DESIGN_SHIPREGISTRY_H_
+#define ATHENA2_MODEL_DESIGN_SHIPREGISTRY_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "dsl.h"
+#include "model/component/componentSet.h"
+#include "model/design/ship.h"
+#include "nlohmann/json.hpp"
+
+namespace athena2::model::design {
+/**
+ * named ship designs that fleets refer to instead of spelling them out
+ *
+ * each design is parsed and validated once and kept in normal form; every
+ * fleet that uses it shares the same copy
+ */
+class ShipRegistry final {
+ public:
+  /**
+   * reads an array of ship designs
+   *
+   * @throws EvalException if a design is invalid or two share a name
+   */
+  static ShipRegistry fromJson(nlohmann::json const &,
+                               component::ComponentSet const &, EvalContext &);
+
+  ShipRegistry() noexcept = default;
+  ShipRegistry(ShipRegistry const &) = delete;
+  ShipRegistry(ShipRegistry &&) noexcept = default;
+
+  ~ShipRegistry() noexcept = default;
+
+  ShipRegistry &operator=(ShipRegistry const &) = delete;
+  ShipRegistry &operator=(ShipRegistry &&) noexcept = default;
+
+  /**
+   * adds a design under the name it was given in its ship object
+   *
+   * @throws EvalException if there's already a design with that name
+   */
+  ShipRegistry &add(std::string const &name, Ship const &, EvalContext &);
+
+  /**
+   * design with this name, or null if there is none
+   */
+  std::shared_ptr<Ship const> get(std::string const &name) const noexcept;
+
+  std::size_t size() const noexcept;
+
+ private:
+  std::unordered_map<std::string, std::shared_ptr<Ship const>> designs;
+};
+}  // namespace athena2::model::design
+
+#endif  // ATHENA2_MODEL_DESIGN_SHIPREGISTRY_H_
@@ -0,0 +1,62 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/entity/damage.h"
+
+#include <array>
+#include <cmath>
+
+using namespace std;
+using namespace athena2::model::component;
+using namespace athena2::model::design;
+
+namespace athena2::model::entity {
+optional<Hit> rollHit(Weapon::Stats const &weapon, Ship const &ship,
+                      float evasion, Rng &rng) noexcept {
+  // chanceToHit = probability of a hit from 0 to 1
+  float tracking =
+      (weapon.tracking + ship.trackingBonus) * (1.f + ship.trackingModifier);
+  float chanceToHit =
+      fminf(1.f, fmaxf(0.f, weapon.accuracy - fmaxf(0.f, evasion - tracking)) +
+                     ship.chanceToHitBonus);
+  // the hit and damage rolls, drawn together
+  array<float, 2> rolls;
+  rng.fill(rolls);
+  bool hits = rolls[0] < chanceToHit;
+  if (!hits) {
+    // missed; no damage done
+    return nullopt;
+  }
+
+  // damage = weapons damage on a hit
+  float damage =
+      weapon.minDamage + (weapon.maxDamage - weapon.minDamage) * rolls[1];
+  if (weapon.explosive)
+    damage *= (1.f + ship.explosiveWeaponsDamageModifier);
+
+  return Hit{
+      .damage = damage,
+      .shieldSkipModifier = weapon.shieldSkipModifier,
+      .shieldDamageModifier = weapon.shieldDamageModifier,
+      .armourSkipModifier = weapon.armourSkipModifier,
+      .armourDamageModifier = weapon.armourDamageModifier,
+      .hullDamageModifier = weapon.hullDamageModifier,
+  };
+}
+}  // namespace athena2::model::entity
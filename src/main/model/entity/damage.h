@@ -0,0 +1,170 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ATHENA2_MODEL_ENTITY_DAMAGE_H_
+#define ATHENA2_MODEL_ENTITY_DAMAGE_H_
+
+#include <array>
+#include <cstddef>
+#include <optional>
+
+#include "model/component/weapon.h"
+#include "model/design/ship.h"
+#include "model/rng.h"
+
+namespace athena2::model::entity {
+/**
+ * a hit that has landed, but hasn't gone through the target's defences yet
+ */
+struct Hit final {
+  float damage;
+  float shieldSkipModifier;
+  float shieldDamageModifier;
+  float armourSkipModifier;
+  float armourDamageModifier;
+  float hullDamageModifier;
+};
+
+/**
+ * a target's defensive layers
+ */
+struct Defences final {
+  float shields;
+  float armour;
+  float hull;
+  float shieldHardening;
+  float armourHardening;
+};
+
+/**
+ * roll to hit something with the given evasion, and roll the damage if it
+ * hits
+ */
+std::optional<Hit> rollHit(component::Weapon::Stats const &weapon,
+                           design::Ship const &ship, float evasion,
+                           Rng &rng) noexcept;
+
+/**
+ * put a hit through shields, then armour, then hull
+ *
+ * written with selects rather than branches so that a loop over a block of
+ * hits can be vectorized, and always inlined so that it's built for whatever
+ * instruction set its caller is
+ *
+ * @param hullDamage set to the hull damage done if the target survives
+ * @returns whether the target survives
+ */
+[[gnu::always_inline]] inline bool penetrate(Hit const &hit,
+                                             Defences &defences,
+                                             float &hullDamage) noexcept {
+  // shield layer; a layer that's broken through is emptied before the
+  // overflow is worked out
+  float shieldSkipped = hit.damage * hit.shieldSkipModifier;
+  float shieldDamaging = hit.damage * (1.f - hit.shieldSkipModifier);
+  shieldDamaging += shieldSkipped * defences.shieldHardening;
+  shieldSkipped -= shieldSkipped * defences.shieldHardening;
+  bool shieldsHold =
+      shieldDamaging < defences.shields / hit.shieldDamageModifier;
+  float shieldOverflow = shieldDamaging - 0.f / hit.shieldDamageModifier;
+  shieldSkipped = shieldsHold ? shieldSkipped : shieldSkipped + shieldOverflow;
+  defences.shields =
+      shieldsHold ? defences.shields - shieldDamaging * hit.shieldDamageModifier
+                  : 0.f;
+
+  // armour layer
+  float armourSkipped = shieldSkipped * hit.armourSkipModifier;
+  float armourDamaging = shieldSkipped * (1.f - hit.armourSkipModifier);
+  armourDamaging += armourSkipped * defences.armourHardening;
+  armourSkipped -= armourSkipped * defences.armourHardening;
+  bool armourHolds =
+      armourDamaging < defences.armour / hit.armourDamageModifier;
+  float armourOverflow = armourDamaging - 0.f / hit.armourDamageModifier;
+  armourSkipped = armourHolds ? armourSkipped : armourSkipped + armourOverflow;
+  defences.armour =
+      armourHolds ? defences.armour - armourDamaging * hit.armourDamageModifier
+                  : 0.f;
+
+  // hull layer
+  bool survives = armourSkipped < defences.hull / hit.hullDamageModifier;
+  hullDamage = armourSkipped * hit.hullDamageModifier;
+  defences.hull = survives ? defences.hull - hullDamage : 0.f;
+  return survives;
+}
+
+/**
+ * a block of hits, one per lane
+ */
+template <size_t N>
+struct HitBlock final {
+  std::array<float, N> damage;
+  std::array<float, N> shieldSkipModifier;
+  std::array<float, N> shieldDamageModifier;
+  std::array<float, N> armourSkipModifier;
+  std::array<float, N> armourDamageModifier;
+  std::array<float, N> hullDamageModifier;
+};
+
+/**
+ * the defences of the targets of a block of hits, one per lane
+ */
+template <size_t N>
+struct DefenceBlock final {
+  std::array<float, N> shields;
+  std::array<float, N> armour;
+  std::array<float, N> hull;
+  std::array<float, N> shieldHardening;
+  std::array<float, N> armourHardening;
+};
+
+/**
+ * put each lane's hit through that lane's defences, as penetrate does
+ *
+ * lanes are independent, so every lane must be a different target; hits on
+ * the same target go in successive blocks, in the order they were fired
+ */
+template <size_t N>
+[[gnu::always_inline]] inline void penetrate(
+    HitBlock<N> const &hits, DefenceBlock<N> &defences,
+    std::array<float, N> &hullDamage, std::array<bool, N> &survives) noexcept {
+  for (size_t lane = 0; lane < N; ++lane) {
+    Defences target = {
+        .shields = defences.shields[lane],
+        .armour = defences.armour[lane],
+        .hull = defences.hull[lane],
+        .shieldHardening = defences.shieldHardening[lane],
+        .armourHardening = defences.armourHardening[lane],
+    };
+    survives[lane] = penetrate(
+        Hit{
+            .damage = hits.damage[lane],
+            .shieldSkipModifier = hits.shieldSkipModifier[lane],
+            .shieldDamageModifier = hits.shieldDamageModifier[lane],
+            .armourSkipModifier = hits.armourSkipModifier[lane],
+            .armourDamageModifier = hits.armourDamageModifier[lane],
+            .hullDamageModifier = hits.hullDamageModifier[lane],
+        },
+        target, hullDamage[lane]);
+    defences.shields[lane] = target.shields;
+    defences.armour[lane] = target.armour;
+    defences.hull[lane] = target.hull;
+  }
+}
+}  // namespace athena2::model::entity
+
+#endif  // ATHENA2_MODEL_ENTITY_DAMAGE_H_
@@ -19,6 +19,9 @@
 
 #include "model/entity/entity.h"
 
+#include <optional>
+
+#include "model/entity/damage.h"
 #include "model/evaluator.h"
 
 using namespace std;
@@ -39,61 +42,29 @@ Entity::Entity(float hull_, float armour_, float armourHardening_,
       evasion(evasion_),
       speed(speed_) {}
 float Entity::rangeTo(Entity const &target) const noexcept {
-  return fabs(position - position);
+  return fabs(position - target.position);
 }
-void Entity::takeDamage(Weapon const &weapon, Ship const &ship,
-                        mt19937_64 &rng) noexcept {
-  // chanceToHit = probability of a hit from 0 to 1
-  float tracking =
-      (weapon.tracking + ship.trackingBonus) * (1.f + ship.trackingModifier);
-  float chanceToHit =
-      fminf(1.f, fmaxf(0.f, weapon.accuracy - fmaxf(0.f, evasion - tracking)) +
-                     ship.chanceToHitBonus);
-  if (!bernoulli_distribution(clamp(chanceToHit, 0.f, 1.f))(rng)) {
-    // missed; no damage done
-    return;
-  }
-
-  // damage = weapons damage on a hit
-  float damage =
-      uniform_real_distribution(weapon.minDamage, weapon.maxDamage)(rng);
-  if (weapon.tag == "explosive")
-    damage *= (1.f + ship.explosiveWeaponsDamageModifier);
-
-  // shield layer
-  float shieldSkipped = damage * weapon.shieldSkipModifier;
-  float shieldDamaging = damage * (1.f - weapon.shieldSkipModifier);
-  shieldDamaging += shieldSkipped * shieldHardening;
-  shieldSkipped -= shieldSkipped * shieldHardening;
-  if (shieldDamaging < shields / weapon.shieldDamageModifier) {
-    shields -= shieldDamaging * weapon.shieldDamageModifier;
-  } else {
-    shields = 0;
-    shieldSkipped += shieldDamaging - shields / weapon.shieldDamageModifier;
-  }
+bool Entity::takeDamage(Weapon::Stats const &weapon, Ship const &ship,
+                        Rng &rng) noexcept {
+  optional<Hit> hit = rollHit(weapon, ship, evasion, rng);
+  if (!hit) return false;
 
-  float armourSkipped = shieldSkipped * weapon.armourSkipModifier;
-  float armourDamaging = shieldSkipped * (1.f - weapon.armourSkipModifier);
-  armourDamaging += armourSkipped * armourHardening;
-  armourSkipped -= armourSkipped * armourHardening;
-  if (armourDamaging < armour / weapon.armourDamageModifier) {
-    armour -= armourDamaging * weapon.armourDamageModifier;
-  } else {
-    armour = 0;
-    armourSkipped += armourDamaging - armour / weapon.armourDamageModifier;
-  }
-
-  if (armourSkipped < hull / weapon.hullDamageModifier) {
-    float hullDamage = armourSkipped * weapon.hullDamageModifier;
-    hull -= hullDamage;
-    checkRetreat(hullDamage, rng);
-  } else {
-    hull = 0;
-    // float overkill = armourSkipped - hull /
-    // component.hullDamageModifier;
-  }
+  Defences defences = {
+      .shields = shields,
+      .armour = armour,
+      .hull = hull,
+      .shieldHardening = shieldHardening,
+      .armourHardening = armourHardening,
+  };
+  float hullDamage;
+  bool survives = penetrate(*hit, defences, hullDamage);
+  shields = defences.shields;
+  armour = defences.armour;
+  hull = defences.hull;
+  if (survives) checkRetreat(hullDamage, rng);
+  return true;
 }
-void Entity::checkRetreat(float, mt19937_64 &) noexcept {}
+void Entity::checkRetreat(float, Rng &) noexcept {}
 void Entity::tick() noexcept {}
 void Entity::moveToRange(Entity const &target, float range) noexcept {
   // find target location
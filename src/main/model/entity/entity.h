@@ -20,10 +20,9 @@
 #ifndef ATHENA2_MODEL_ENTITY_ENTITY_H_
 #define ATHENA2_MODEL_ENTITY_ENTITY_H_
 
-#include <random>
-
 #include "model/component/weapon.h"
 #include "model/design/ship.h"
+#include "model/rng.h"
 
 namespace athena2::model::entity {
 class Entity {
@@ -41,9 +40,12 @@ class Entity {
 
   float rangeTo(Entity const &target) const noexcept;
 
-  void takeDamage(component::Weapon const &weapon, design::Ship const &ship,
-                  std::mt19937_64 &rng) noexcept;
-  virtual void checkRetreat(float damage, std::mt19937_64 &rng) noexcept;
+  /**
+   * @returns whether the shot hit
+   */
+  bool takeDamage(component::Weapon::Stats const &weapon,
+                  design::Ship const &ship, Rng &rng) noexcept;
+  virtual void checkRetreat(float damage, Rng &rng) noexcept;
   virtual void tick() noexcept;
 
   void moveToRange(Entity const &target, float range) noexcept;
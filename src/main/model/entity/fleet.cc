@@ -28,7 +28,7 @@ namespace athena2::model::entity {
 Fleet::Fleet(design::Fleet const &design, float position) noexcept {
   for (auto const &[ship, count] : design.ships) {
     for (size_t idx = 0; idx < count; ++idx) {
-      ships.emplace_back(ship, position);
+      ships.emplace_back(*ship, position, ships.size());
     }
   }
 }
@@ -27,19 +27,28 @@ using namespace athena2::model::design;
 using namespace nlohmann;
 
 namespace athena2::model::entity {
-Projectile::Projectile(component::Weapon const &weapon_,
-                       Ship const &ship_) noexcept
+Projectile::Projectile(component::Weapon::Stats const &weapon_,
+                       Ship const &ship_, Rng const &rng_) noexcept
     : Entity(weapon_.data.projectileWeapon.projectileHull,
              weapon_.data.projectileWeapon.projectileArmour, 0.f, 0.f, 0.f,
              weapon_.data.projectileWeapon.projectileEvasion, ship_.position,
              weapon_.data.projectileWeapon.projectileSpeed),
       weapon(&weapon_),
-      ship(ship_.design) {}
+      ship(ship_.design),
+      rng(rng_),
+      count(1) {}
 bool Projectile::inRange(Entity const &target) const noexcept {
   return rangeTo(target) <=
          weapon->data.projectileWeapon.projectileSpeed * TIME_QUANTUM;
 }
+Projectile Projectile::member() const noexcept {
+  Projectile result = *this;
+  result.rng = rng.stream(count - 1);
+  result.count = 1;
+  return result;
+}
 void to_json(json &j, Projectile const &p) noexcept {
-  return to_json(j, static_cast<Entity const &>(p));
+  to_json(j, static_cast<Entity const &>(p));
+  j["count"] = p.count;
 }
 }  // namespace athena2::model::entity
@@ -20,15 +20,23 @@
 #ifndef ATHENA2_MODEL_ENTITY_PROJECTILE_H_
 #define ATHENA2_MODEL_ENTITY_PROJECTILE_H_
 
+#include <cstddef>
+
 #include "model/component/weapon.h"
 #include "model/design/ship.h"
 #include "model/entity/entity.h"
 #include "model/entity/ship.h"
+#include "model/rng.h"
 
 namespace athena2::model::entity {
+/**
+ * a salvo of identical projectiles launched together by one ship; they fly as
+ * one, and a member is only split off when it's damaged
+ */
 class Projectile final : public Entity {
  public:
-  Projectile(component::Weapon const &, Ship const &) noexcept;
+  Projectile(component::Weapon::Stats const &, Ship const &,
+             Rng const &) noexcept;
 
   Projectile(Projectile const &) noexcept = default;
   Projectile(Projectile &&) noexcept = default;
@@ -39,9 +47,22 @@ class Projectile final : public Entity {
   Projectile &operator=(Projectile &&) noexcept = default;
 
   bool inRange(Entity const &target) const noexcept;
+  /**
+   * a copy of one member of this salvo, as a salvo of its own
+   */
+  Projectile member() const noexcept;
 
-  component::Weapon const *weapon;
+  /**
+   * stats of the weapon that launched this salvo
+   */
+  component::Weapon::Stats const *weapon;
   design::Ship const *ship;
+  /**
+   * stream keyed by the shot that launched this salvo; each member hits with
+   * its own substream
+   */
+  Rng rng;
+  std::size_t count;
 };
 void to_json(nlohmann::json &, Projectile const &) noexcept;
 }  // namespace athena2::model::entity
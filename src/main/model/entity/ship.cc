@@ -28,105 +28,108 @@ using namespace athena2::model::design;
 using namespace nlohmann;
 
 namespace athena2::model::entity {
-Weapon::Weapon(component::Weapon const &weapon_,
-               design::Ship const &ship_) noexcept
-    : component(&weapon_), ship(&ship_) {
-  switch (component->type) {
-    case component::Weapon::Type::REGULAR: {
-      data.regularWeapon.cooldown = 0.f;
-      break;
-    }
-    case component::Weapon::Type::PROJECTILE: {
-      data.projectileWeapon.cooldown = 0.f;
-      break;
-    }
-    case component::Weapon::Type::HANGAR: {
-      data.hangarWeapon.unitsStored =
-          component->data.hangarWeapon.unitsPerHangar;
-      break;
-    }
-  }
+Weapon::Weapon(component::Weapon const &weapon_, design::Ship const &ship_,
+               size_t slot_) noexcept
+    : component(&weapon_),
+      stats(weapon_.stats),
+      ship(&ship_),
+      slot(slot_),
+      shots(0) {}
+RegularWeapon::RegularWeapon(component::Weapon const &weapon_,
+                             design::Ship const &ship_, size_t slot_) noexcept
+    : Weapon(weapon_, ship_, slot_), cooldown(0.f) {}
+void RegularWeapon::fire() noexcept {
+  ++shots;
+  cooldown = stats->cooldown;
 }
-void Weapon::fire() noexcept {
-  switch (component->type) {
-    case component::Weapon::Type::REGULAR: {
-      data.regularWeapon.cooldown = component->cooldown;
-      break;
-    }
-    case component::Weapon::Type::PROJECTILE: {
-      data.projectileWeapon.cooldown = component->cooldown;
-      break;
-    }
-    case component::Weapon::Type::HANGAR: {
-      --data.hangarWeapon.unitsStored;
-      break;
-    }
-  }
+void RegularWeapon::tick(Ship const &shipEntity) noexcept {
+  if (cooldown > 0.f)
+    cooldown -= TIME_QUANTUM * (1.f + ship->fireRateModifier) *
+                (0.5f + 0.5f * (shipEntity.hull / ship->hullHealth));
 }
-void Weapon::tick(Ship const &shipEntity) noexcept {
-  switch (component->type) {
-    case component::Weapon::Type::REGULAR: {
-      if (data.regularWeapon.cooldown > 0.f)
-        data.regularWeapon.cooldown -=
-            TIME_QUANTUM * (1.f + ship->fireRateModifier) *
-            (0.5f + 0.5f * (shipEntity.hull / ship->hullHealth));
-      break;
-    }
-    case component::Weapon::Type::PROJECTILE: {
-      if (data.projectileWeapon.cooldown)
-        data.projectileWeapon.cooldown -=
-            TIME_QUANTUM * (1.f + ship->fireRateModifier) *
-            (0.5f + 0.5f * (shipEntity.hull / ship->hullHealth));
-      break;
-    }
-    case component::Weapon::Type::HANGAR: {
-      if (data.hangarWeapon.unitsStored <
-          component->data.hangarWeapon.unitsPerHangar)
-        data.hangarWeapon.unitsStored +=
-            component->data.hangarWeapon.regenerationPerDay * TIME_QUANTUM;
-      break;
-    }
-  }
+void to_json(json &j, RegularWeapon const &w) noexcept {
+  j["name"] = w.component->name;
+  j["cooldown"] = w.cooldown;
+}
+ProjectileWeapon::ProjectileWeapon(component::Weapon const &weapon_,
+                                   design::Ship const &ship_,
+                                   size_t slot_) noexcept
+    : Weapon(weapon_, ship_, slot_), cooldown(0.f) {}
+void ProjectileWeapon::fire() noexcept {
+  ++shots;
+  cooldown = stats->cooldown;
+}
+void ProjectileWeapon::tick(Ship const &shipEntity) noexcept {
+  if (cooldown)
+    cooldown -= TIME_QUANTUM * (1.f + ship->fireRateModifier) *
+                (0.5f + 0.5f * (shipEntity.hull / ship->hullHealth));
 }
-void to_json(json &j, Weapon const &w) noexcept {
+void to_json(json &j, ProjectileWeapon const &w) noexcept {
   j["name"] = w.component->name;
-  switch (w.component->type) {
-    case component::Weapon::Type::REGULAR: {
-      j["cooldown"] = w.data.regularWeapon.cooldown;
-      break;
-    }
-    case component::Weapon::Type::PROJECTILE: {
-      j["cooldown"] = w.data.projectileWeapon.cooldown;
-      break;
-    }
-    case component::Weapon::Type::HANGAR: {
-      j["unitsStored"] = w.data.hangarWeapon.unitsStored;
-      break;
-    }
-  }
+  j["cooldown"] = w.cooldown;
+}
+HangarWeapon::HangarWeapon(component::Weapon const &weapon_,
+                           design::Ship const &ship_, size_t slot_) noexcept
+    : Weapon(weapon_, ship_, slot_),
+      unitsStored(stats->data.hangarWeapon.unitsPerHangar) {}
+void HangarWeapon::fire() noexcept {
+  ++shots;
+  --unitsStored;
+}
+void HangarWeapon::tick() noexcept {
+  if (unitsStored < stats->data.hangarWeapon.unitsPerHangar)
+    unitsStored += stats->data.hangarWeapon.regenerationPerDay * TIME_QUANTUM;
 }
-Ship::Ship(design::Ship const &design_, float position_) noexcept
+void to_json(json &j, HangarWeapon const &w) noexcept {
+  j["name"] = w.component->name;
+  j["unitsStored"] = w.unitsStored;
+}
+Ship::Ship(design::Ship const &design_, float position_, size_t id_) noexcept
     : Entity(design_.hullHealth, design_.armourHealth, design_.armourHardening,
              design_.shieldHealth, design_.shieldHardening, design_.evasion,
              position_, design_.speed),
-      weapons(),
+      regularWeapons(),
+      projectileWeapons(),
+      hangarWeapons(),
       design(&design_),
+      id(id_),
       disengageChancesRemaining(design->disengageChances),
       willDisengage(false) {
+  size_t slot = 0;
   for (design::Section const &section : design_.sections) {
     for (component::Weapon const *weapon : section.weapons) {
-      weapons.emplace_back(*weapon, design_);
+      switch (weapon->stats->type) {
+        case component::Weapon::Type::REGULAR: {
+          regularWeapons.emplace_back(*weapon, design_, slot);
+          break;
+        }
+        case component::Weapon::Type::PROJECTILE: {
+          projectileWeapons.emplace_back(*weapon, design_, slot);
+          break;
+        }
+        case component::Weapon::Type::HANGAR: {
+          hangarWeapons.emplace_back(*weapon, design_, slot);
+          break;
+        }
+      }
+      ++slot;
     }
   }
 }
 bool Ship::inRange(Weapon const &weapon, Entity const &target) const noexcept {
   float range = rangeTo(target);
-  return weapon.component->minRange <= range &&
-         range <=
-             weapon.component->maxRange * (1.f + design->weaponsRangeModifier);
+  component::Weapon::Stats const &stats = *weapon.stats;
+  return stats.minRange <= range &&
+         range <= stats.maxRange * (1.f + design->weaponsRangeModifier);
+}
+void Ship::checkRetreat(float hullDamage, Rng &rng) noexcept {
+  checkRetreat(*design, hull, hullDamage, disengageChancesRemaining,
+               willDisengage, rng);
 }
-void Ship::checkRetreat(float hullDamage, mt19937_64 &rng) noexcept {
-  if (hull > design->hullHealth * 0.5f)
+void Ship::checkRetreat(design::Ship const &design, float hull,
+                        float hullDamage, float &disengageChancesRemaining,
+                        bool &willDisengage, Rng &rng) noexcept {
+  if (hull > design.hullHealth * 0.5f)
     return;  // won't retreat when over 50% hull
 
   if (disengageChancesRemaining <= 0.f)
@@ -135,19 +138,30 @@ void Ship::checkRetreat(float hullDamage, mt19937_64 &rng) noexcept {
   disengageChancesRemaining -= 1.f;
 
   float disengageChance =
-      hullDamage / design->hullHealth * 1.5f * design->disengageChanceModifier;
-  willDisengage = bernoulli_distribution(disengageChance)(rng);
+      hullDamage / design.hullHealth * 1.5f * design.disengageChanceModifier;
+  willDisengage = rng.bernoulli(disengageChance);
 }
 void Ship::tick() noexcept {
   hull = fminf(design->hullHealth, hull + design->hullRegen);
   armour = fminf(design->armourHealth, armour + design->armourRegen);
   shields = fminf(design->shieldHealth, shields + design->shieldRegen);
 
-  for (Weapon &weapon : weapons) weapon.tick(*this);
+  for (RegularWeapon &weapon : regularWeapons) weapon.tick(*this);
+  for (ProjectileWeapon &weapon : projectileWeapons) weapon.tick(*this);
+  for (HangarWeapon &weapon : hangarWeapons) weapon.tick();
 }
 void to_json(json &j, Ship const &s) noexcept {
   to_json(j, static_cast<Entity const &>(s));
-  j["weapons"] = static_cast<json>(s.weapons);
+  // weapons are listed in slot order, whatever their type
+  vector<json> weapons(s.regularWeapons.size() + s.projectileWeapons.size() +
+                       s.hangarWeapons.size());
+  for (RegularWeapon const &weapon : s.regularWeapons)
+    weapons[weapon.slot] = static_cast<json>(weapon);
+  for (ProjectileWeapon const &weapon : s.projectileWeapons)
+    weapons[weapon.slot] = static_cast<json>(weapon);
+  for (HangarWeapon const &weapon : s.hangarWeapons)
+    weapons[weapon.slot] = static_cast<json>(weapon);
+  j["weapons"] = weapons;
   j["disengageChancesRemaining"] = s.disengageChancesRemaining;
 }
 }  // namespace athena2::model::entity
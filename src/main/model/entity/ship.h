@@ -20,6 +20,8 @@
 #ifndef ATHENA2_MODEL_ENTITY_SHIP_H_
 #define ATHENA2_MODEL_ENTITY_SHIP_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 #include "model/component/weapon.h"
@@ -28,9 +30,16 @@
 
 namespace athena2::model::entity {
 class Ship;
-class Weapon final {
+/**
+ * state common to weapons of every type
+ *
+ * a ship keeps its weapons of each type in their own array, so each type is
+ * fired and ticked in its own loop
+ */
+class Weapon {
  public:
-  Weapon(component::Weapon const &, design::Ship const &) noexcept;
+  Weapon(component::Weapon const &, design::Ship const &,
+         std::size_t slot) noexcept;
 
   Weapon(Weapon const &) noexcept = default;
   Weapon(Weapon &&) noexcept = default;
@@ -40,27 +49,61 @@ class Weapon final {
   Weapon &operator=(Weapon const &) noexcept = default;
   Weapon &operator=(Weapon &&) noexcept = default;
 
+  /**
+   * the weapon's design, only read for its name
+   */
+  component::Weapon const *component;
+  /**
+   * the weapon's combat stats, from its component set's table
+   */
+  component::Weapon::Stats const *stats;
+  design::Ship const *ship;
+  /**
+   * position of this weapon among all of its ship's weapons, used to key its
+   * random streams
+   */
+  std::size_t slot;
+  /**
+   * number of times this weapon has fired, used to key its random streams
+   */
+  std::uint64_t shots;
+};
+class RegularWeapon final : public Weapon {
+ public:
+  RegularWeapon(component::Weapon const &, design::Ship const &,
+                std::size_t slot) noexcept;
+
   void fire() noexcept;
   void tick(Ship const &) noexcept;
 
-  component::Weapon const *component;
-  design::Ship const *ship;
-  union {
-    struct {
-      float cooldown;
-    } regularWeapon;
-    struct {
-      float cooldown;
-    } projectileWeapon;
-    struct {
-      float unitsStored;
-    } hangarWeapon;
-  } data;
+  float cooldown;
 };
-void to_json(nlohmann::json &, Weapon const &) noexcept;
+void to_json(nlohmann::json &, RegularWeapon const &) noexcept;
+class ProjectileWeapon final : public Weapon {
+ public:
+  ProjectileWeapon(component::Weapon const &, design::Ship const &,
+                   std::size_t slot) noexcept;
+
+  void fire() noexcept;
+  void tick(Ship const &) noexcept;
+
+  float cooldown;
+};
+void to_json(nlohmann::json &, ProjectileWeapon const &) noexcept;
+class HangarWeapon final : public Weapon {
+ public:
+  HangarWeapon(component::Weapon const &, design::Ship const &,
+               std::size_t slot) noexcept;
+
+  void fire() noexcept;
+  void tick() noexcept;
+
+  float unitsStored;
+};
+void to_json(nlohmann::json &, HangarWeapon const &) noexcept;
 class Ship final : public Entity {
  public:
-  Ship(design::Ship const &, float position) noexcept;
+  Ship(design::Ship const &, float position, std::size_t id) noexcept;
 
   Ship(Ship const &) noexcept = default;
   Ship(Ship &&) noexcept = default;
@@ -71,11 +114,25 @@ class Ship final : public Entity {
   Ship &operator=(Ship &&) noexcept = default;
 
   bool inRange(Weapon const &weapon, Entity const &target) const noexcept;
-  void checkRetreat(float hullDamage, std::mt19937_64 &rng) noexcept override;
+  void checkRetreat(float hullDamage, Rng &rng) noexcept override;
   void tick() noexcept override;
 
-  std::vector<Weapon> weapons;
+  /**
+   * checkRetreat, for ship state that isn't stored in a Ship
+   */
+  static void checkRetreat(design::Ship const &design, float hull,
+                           float hullDamage, float &disengageChancesRemaining,
+                           bool &willDisengage, Rng &rng) noexcept;
+
+  std::vector<RegularWeapon> regularWeapons;
+  std::vector<ProjectileWeapon> projectileWeapons;
+  std::vector<HangarWeapon> hangarWeapons;
   design::Ship const *design;
+  /**
+   * index of this ship in its fleet as deployed, used to key its random
+   * streams
+   */
+  std::size_t id;
   float disengageChancesRemaining;
   bool willDisengage;
 };
@@ -21,31 +21,51 @@
 
 #include "model/evaluator.h"
 
+using namespace std;
 using namespace athena2::model::component;
 using namespace athena2::model::entity;
 using namespace athena2::model::design;
 using namespace nlohmann;
 
 namespace athena2::model::entity {
-StrikeCraft::StrikeCraft(component::Weapon const &weapon_,
-                         Ship const &ship_) noexcept
+StrikeCraft::StrikeCraft(component::Weapon::Stats const &weapon_,
+                         Ship const &ship_, Rng const &rng_,
+                         uint64_t firstLaunch_, size_t count_) noexcept
     : Entity(weapon_.data.hangarWeapon.strikeCraftHull,
              weapon_.data.hangarWeapon.strikeCraftArmour, 0.f,
              weapon_.data.hangarWeapon.strikeCraftHull, 0.f,
              weapon_.data.hangarWeapon.strikeCraftEvasion, ship_.position,
              weapon_.data.hangarWeapon.strikeCraftSpeed),
       weapon(&weapon_),
-      ship(ship_.design) {}
+      ship(ship_.design),
+      cooldown(0.f),
+      rng(rng_),
+      firstLaunch(firstLaunch_),
+      count(count_),
+      shots(0) {}
 bool StrikeCraft::inRange(Entity const &target) const noexcept {
   return rangeTo(target) < weapon->data.hangarWeapon.strikeCraftRange *
                                (1.f + ship->weaponsRangeModifier);
 }
-void StrikeCraft::fire() noexcept { cooldown = weapon->cooldown; }
+void StrikeCraft::fire() noexcept {
+  cooldown = weapon->cooldown;
+  ++shots;
+}
 void StrikeCraft::tick() noexcept {
   cooldown -= TIME_QUANTUM * (1.f + ship->fireRateModifier);
 }
+Rng StrikeCraft::memberRng(size_t member) const noexcept {
+  return rng.stream(firstLaunch + member);
+}
+StrikeCraft StrikeCraft::member() const noexcept {
+  StrikeCraft result = *this;
+  result.firstLaunch = firstLaunch + count - 1;
+  result.count = 1;
+  return result;
+}
 void to_json(json &j, StrikeCraft const &s) noexcept {
   to_json(j, static_cast<Entity const &>(s));
   j["cooldown"] = s.cooldown;
+  j["count"] = s.count;
 }
 }  // namespace athena2::model::entity
@@ -20,15 +20,25 @@
 #ifndef ATHENA2_MODEL_ENTITY_STRIKECRAFT_H_
 #define ATHENA2_MODEL_ENTITY_STRIKECRAFT_H_
 
+#include <cstddef>
+#include <cstdint>
+
 #include "model/component/weapon.h"
 #include "model/design/ship.h"
 #include "model/entity/entity.h"
 #include "model/entity/ship.h"
+#include "model/rng.h"
 
 namespace athena2::model::entity {
+/**
+ * a squadron of identical strike craft launched together by one hangar; they
+ * move and attack as one, and a member is only split off when it's damaged
+ */
 class StrikeCraft final : public Entity {
  public:
-  StrikeCraft(component::Weapon const &, entity::Ship const &) noexcept;
+  StrikeCraft(component::Weapon::Stats const &, entity::Ship const &,
+              Rng const &, std::uint64_t firstLaunch,
+              std::size_t count) noexcept;
 
   StrikeCraft(StrikeCraft const &) noexcept = default;
   StrikeCraft(StrikeCraft &&) noexcept = default;
@@ -41,10 +51,29 @@ class StrikeCraft final : public Entity {
   bool inRange(Entity const &) const noexcept;
   void fire() noexcept;
   void tick() noexcept override;
+  /**
+   * the stream of one member of this squadron
+   */
+  Rng memberRng(std::size_t member) const noexcept;
+  /**
+   * a copy of the last member of this squadron, as a squadron of its own
+   */
+  StrikeCraft member() const noexcept;
 
-  component::Weapon const *weapon;
+  /**
+   * stats of the hangar that launched this squadron
+   */
+  component::Weapon::Stats const *weapon;
   design::Ship const *ship;
   float cooldown;
+  /**
+   * stream of the hangar that launched this squadron; each member's stream is
+   * keyed by its launch, and each attack draws from its own substream of that
+   */
+  Rng rng;
+  std::uint64_t firstLaunch;
+  std::size_t count;
+  std::uint64_t shots;
 };
 void to_json(nlohmann::json &, StrikeCraft const &) noexcept;
 }  // namespace athena2::model::entity
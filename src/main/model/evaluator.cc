@@ -19,12 +19,20 @@
 
 #include "model/evaluator.h"
 
+#include <algorithm>
+#include <array>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <numeric>
-#include <random>
+#include <span>
+#include <utility>
+#include <vector>
 
 #include "model/design/fleet.h"
 #include "model/entity/fleet.h"
+#include "model/lockstep.h"
+#include "model/rng.h"
 #include "nlohmann/json.hpp"
 
 using namespace athena2::model::design;
@@ -39,121 +47,586 @@ float engagementRange(design::Fleet const &fleet) {
   float maxEngagementRange = 0.f;
   for (auto const &[ship, _] : fleet.ships) {
     float maxWeaponRange = 0.f;
-    for (design::Section const &section : ship.sections) {
+    for (design::Section const &section : ship->sections) {
       for (component::Weapon const *const &weapon : section.weapons) {
-        if (weapon->maxRange > maxWeaponRange)
-          maxWeaponRange = weapon->maxRange * (1.f + ship.weaponsRangeModifier);
+        if (weapon->stats->maxRange > maxWeaponRange)
+          maxWeaponRange =
+              weapon->stats->maxRange * (1.f + ship->weaponsRangeModifier);
       }
     }
     float shipEngagementRange =
-        maxWeaponRange * (1.f + ship.engagementRangeModifier);
+        maxWeaponRange * (1.f + ship->engagementRangeModifier);
     if (shipEngagementRange > maxEngagementRange)
       maxEngagementRange = shipEngagementRange;
   }
   return maxEngagementRange;
 }
-}  // namespace
 
-void fireWeapons(entity::Fleet &firing, entity::Fleet &targets,
-                 mt19937_64 &rng) noexcept {
-  // for each ship
-  for (entity::Ship &ship : firing.ships) {
-    // for each weapon
-    for (entity::Weapon &weapon : ship.weapons) {
-      switch (weapon.component->type) {
-        case component::Weapon::Type::REGULAR: {
-          // must have cooled down
-          if (weapon.data.regularWeapon.cooldown > 0.f) break;
-
-          // find closest target in range
-          Entity *target = nullptr;
-          for (Entity &candidate : targets.ships) {
-            if (ship.inRange(weapon, candidate) &&
-                (!target || ship.rangeTo(candidate) < ship.rangeTo(*target))) {
-              target = &candidate;
-            }
-          }
-
-          // also look at small targets for PD
-          if (weapon.component->tag == "point-defence") {
-            for (Entity &candidate : targets.projectiles) {
-              if (ship.inRange(weapon, candidate) &&
-                  (!target ||
-                   ship.rangeTo(candidate) < ship.rangeTo(*target))) {
-                target = &candidate;
-              }
-            }
-            for (Entity &candidate : targets.strikeCraft) {
-              if (ship.inRange(weapon, candidate) &&
-                  (!target ||
-                   ship.rangeTo(candidate) < ship.rangeTo(*target))) {
-                target = &candidate;
-              }
-            }
-          }
-
-          // fire if we have a target
-          if (target) {
-            weapon.fire();
-            target->takeDamage(*weapon.component, *ship.design, rng);
-          }
-          break;
-        }
-        case component::Weapon::Type::PROJECTILE: {
-          // must have cooled down
-          if (weapon.data.projectileWeapon.cooldown > 0.f) break;
-
-          // fire if there's a ship in range
-          if (any_of(targets.ships.begin(), targets.ships.end(),
-                     [&weapon, &ship](Entity const &target) {
-                       return ship.inRange(weapon, target);
-                     })) {
-            weapon.fire();
-            // TODO: add a target to projectiles and implement the retarget
-            // mechanic
-            firing.projectiles.emplace_back(*weapon.component, ship);
-          }
-          break;
-        }
-        case component::Weapon::Type::HANGAR: {
-          // must have craft available to deploy
-          if (weapon.data.hangarWeapon.unitsStored < 1.f) break;
-
-          // deploy all strike craft
-          while (weapon.data.hangarWeapon.unitsStored >= 1.f) {
-            weapon.fire();
-            firing.strikeCraft.emplace_back(*weapon.component, ship);
-          }
-          break;
+/**
+ * number of ticks the moving fleet is guaranteed not to interact with the
+ * opponent, assuming both fleets do nothing but close distance
+ *
+ * fills headings with the direction each ship in the moving fleet travels in
+ * during those ticks, -1 or +1; a result of zero means the fleets may interact
+ * this tick
+ */
+size_t quietTicks(entity::Fleet const &moving, entity::Fleet const &opponent,
+                  vector<int> &headings) noexcept {
+  if (!moving.projectiles.empty() || !moving.strikeCraft.empty()) return 0;
+
+  float maxOpponentSpeed = 0.f;
+  for (entity::Ship const &target : opponent.ships)
+    maxOpponentSpeed = fmaxf(maxOpponentSpeed, target.speed);
+
+  // each estimate below leaves a tick of margin against rounding
+  float limit = numeric_limits<float>::infinity();
+  headings.clear();
+  for (entity::Ship const &ship : moving.ships) {
+    float closing = (ship.speed + maxOpponentSpeed) * TIME_QUANTUM;
+
+    for (entity::HangarWeapon const &weapon : ship.hangarWeapons) {
+      // strike craft launch as soon as one is ready, no matter the range
+      float stored = weapon.unitsStored;
+      if (stored >= 1.f) return 0;
+      float regen =
+          weapon.stats->data.hangarWeapon.regenerationPerDay * TIME_QUANTUM;
+      if (regen > 0.f) limit = fminf(limit, (1.f - stored) / regen - 1.f);
+    }
+
+    // true if the weapon can fire now
+    auto inRange = [&ship, &opponent, &closing,
+                    &limit](entity::Weapon const &weapon) {
+      float minRange = weapon.stats->minRange;
+      float maxRange = weapon.stats->maxRange *
+                       (1.f + ship.design->weaponsRangeModifier);
+      for (entity::Ship const &target : opponent.ships) {
+        float range = ship.rangeTo(target);
+        if (minRange <= range && range <= maxRange) return true;
+        float gap = range < minRange ? minRange - range : range - maxRange;
+        limit = fminf(limit, gap / closing - 1.f);
+      }
+      return false;
+    };
+    for (entity::RegularWeapon const &weapon : ship.regularWeapons)
+      if (inRange(weapon)) return 0;
+    for (entity::ProjectileWeapon const &weapon : ship.projectileWeapons)
+      if (inRange(weapon)) return 0;
+
+    // ship must head the same way no matter which opponent is closest, and
+    // must not arrive at its preferred range
+    int heading = 0;
+    for (entity::Ship const &target : opponent.ships) {
+      float range = ship.rangeTo(target);
+      if (range <= 0.f) return 0;
+      float smallerCandidate = target.position - ship.design->preferredRange;
+      float largerCandidate = target.position + ship.design->preferredRange;
+      float destination = fabs(ship.position - smallerCandidate) <
+                                  fabs(ship.position - largerCandidate)
+                              ? smallerCandidate
+                              : largerCandidate;
+      int targetHeading = destination < ship.position ? -1 : 1;
+      if (heading != 0 && heading != targetHeading) return 0;
+      heading = targetHeading;
+      float approach =
+          fabs(destination - ship.position) - TIME_QUANTUM * ship.speed;
+      limit = fminf(limit, range / closing - 1.f);
+      limit = fminf(limit, approach / closing - 1.f);
+    }
+    headings.push_back(heading);
+  }
+
+  // limit is infinite if nothing ever closes distance
+  return limit < 1.f ? 0 : static_cast<size_t>(fminf(limit, 1e6f));
+}
+
+/**
+ * mineral-equivalents destroyed or withdrawn from a fleet so far
+ */
+float losses(entity::Fleet const &fleet, float withdrawMultiplier) noexcept {
+  return accumulate(fleet.destroyed.begin(), fleet.destroyed.end(), 0.f,
+                    [](float rsf, entity::Ship const &ship) {
+                      return rsf + ship.design->cost;
+                    }) +
+         withdrawMultiplier *
+             accumulate(fleet.disengaged.begin(), fleet.disengaged.end(), 0.f,
+                        [](float rsf, entity::Ship const &ship) {
+                          return rsf + ship.design->cost;
+                        });
+}
+
+/**
+ * upper bound on the number of shots something with the given cooldown can
+ * take in the given time
+ */
+float maxShots(float cooldown, float fireRateModifier, float time) noexcept {
+  float ticks = ceilf(time / TIME_QUANTUM) + 1.f;
+  if (cooldown <= 0.f) return ticks;
+  float rate = fmaxf(0.f, 1.f + fireRateModifier) / cooldown;
+  return fminf(ticks, ticks * TIME_QUANTUM * rate + 2.f);
+}
+
+/**
+ * upper bound on the hull damage a single hit from a weapon can do
+ *
+ * infinite if the weapon can destroy a ship no matter how much hull it has
+ * left - a zero damage modifier against a depleted shield or armour layer
+ * produces NaN damage, and a negative hull damage modifier always destroys
+ */
+float maxHullDamage(component::Weapon::Stats const &weapon,
+                    design::Ship const &ship) noexcept {
+  if (weapon.shieldDamageModifier <= 0.f ||
+      weapon.armourDamageModifier <= 0.f || weapon.hullDamageModifier < 0.f)
+    return numeric_limits<float>::infinity();
+  float damage = weapon.maxDamage;
+  if (weapon.explosive)
+    damage *= fmaxf(0.f, 1.f + ship.explosiveWeaponsDamageModifier);
+  return damage * weapon.hullDamageModifier;
+}
+
+/**
+ * upper bound on the hits and total hull damage a fleet can deal in the given
+ * time
+ */
+pair<float, float> maxDamage(entity::Fleet const &attacking,
+                             float time) noexcept {
+  float hits = 0.f;
+  float hullDamage = 0.f;
+  auto addHits = [&hits, &hullDamage](float count, float damage) {
+    hits += count;
+    hullDamage += count * damage;
+  };
+
+  for (entity::Ship const &ship : attacking.ships) {
+    auto addShots = [&ship, &addHits, time](entity::Weapon const &weapon) {
+      component::Weapon::Stats const &stats = *weapon.stats;
+      addHits(maxShots(stats.cooldown, ship.design->fireRateModifier, time),
+              maxHullDamage(stats, *ship.design));
+    };
+    for (entity::RegularWeapon const &weapon : ship.regularWeapons)
+      addShots(weapon);
+    for (entity::ProjectileWeapon const &weapon : ship.projectileWeapons)
+      addShots(weapon);
+    for (entity::HangarWeapon const &weapon : ship.hangarWeapons) {
+      component::Weapon::Stats const &stats = *weapon.stats;
+      float launched = weapon.unitsStored +
+                       stats.data.hangarWeapon.regenerationPerDay *
+                           (ceilf(time / TIME_QUANTUM) + 1.f) * TIME_QUANTUM;
+      addHits(
+          launched * maxShots(stats.cooldown, ship.design->fireRateModifier,
+                              time),
+          maxHullDamage(stats, *ship.design));
+    }
+  }
+  for (entity::Projectile const &projectile : attacking.projectiles)
+    addHits(static_cast<float>(projectile.count),
+            maxHullDamage(*projectile.weapon, *projectile.ship));
+  for (entity::StrikeCraft const &strikeCraft : attacking.strikeCraft)
+    addHits(static_cast<float>(strikeCraft.count) *
+                maxShots(strikeCraft.weapon->cooldown,
+                         strikeCraft.ship->fireRateModifier, time),
+            maxHullDamage(*strikeCraft.weapon, *strikeCraft.ship));
+
+  return pair(hits, hullDamage);
+}
+
+/**
+ * upper bound on the further losses a fleet can take from the given number of
+ * hits doing the given total hull damage
+ *
+ * a ship is lost once it takes enough hull damage to be destroyed, or to drop
+ * below half hull if it can still disengage; the bound is the better of
+ * losing the most expensive ships one hit each, and a fractional knapsack over
+ * the hull damage needed to lose each ship
+ */
+float maxFurtherLosses(entity::Fleet const &defending,
+                       pair<float, float> const &damage,
+                       float withdrawMultiplier) noexcept {
+  auto const &[hits, hullDamage] = damage;
+  vector<pair<float, float>> ships;  // value, hull damage needed
+  for (entity::Ship const &ship : defending.ships) {
+    float needed = ship.hull;
+    if (ship.disengageChancesRemaining > 0.f)
+      needed -= ship.design->hullHealth * 0.5f;
+    ships.emplace_back(ship.design->cost * fmaxf(1.f, withdrawMultiplier),
+                       fmaxf(0.f, needed));
+  }
+
+  sort(ships.begin(), ships.end(),
+       [](pair<float, float> const &a, pair<float, float> const &b) {
+         return a.first > b.first;
+       });
+  float byHits = 0.f;
+  for (size_t idx = 0; idx < ships.size() && static_cast<float>(idx) < hits;
+       ++idx)
+    byHits += ships[idx].first;
+
+  if (isinf(hullDamage)) return byHits;
+  sort(ships.begin(), ships.end(),
+       [](pair<float, float> const &a, pair<float, float> const &b) {
+         return a.first * b.second > b.first * a.second;
+       });
+  float byDamage = 0.f;
+  float budget = hullDamage;
+  for (auto const &[value, needed] : ships) {
+    if (needed <= budget) {
+      byDamage += value;
+      budget -= needed;
+    } else {
+      byDamage += value * budget / needed;
+      break;
+    }
+  }
+
+  return fminf(byHits, byDamage);
+}
+
+/**
+ * move every ship in a fleet one tick along its heading
+ *
+ * equivalent to move during a quiet window, since no ship reaches its
+ * destination
+ */
+void drift(entity::Fleet &moving, vector<int> const &headings) noexcept {
+  for (size_t idx = 0; idx < moving.ships.size(); ++idx) {
+    entity::Ship &ship = moving.ships[idx];
+    if (headings[idx] < 0)
+      ship.position -= TIME_QUANTUM * ship.speed;
+    else
+      ship.position += TIME_QUANTUM * ship.speed;
+  }
+}
+
+/**
+ * a shot picked in the first phase of firing, and applied in the second
+ */
+struct Shot final {
+  enum class Target {
+    SHIP,
+    SALVO,
+    SQUADRON,
+  };
+
+  size_t target;
+  component::Weapon::Stats const *weapon;
+  design::Ship const *ship;
+  Rng rng;
+  Target kind;
+};
+
+/**
+ * everything one ship or squadron does in a tick's firing
+ */
+struct Volley final {
+  vector<Shot> shots;
+  vector<entity::Projectile> projectiles;
+  vector<entity::StrikeCraft> strikeCraft;
+};
+
+/**
+ * what the weapons in a pair of fleets can do; the fight loop is compiled once
+ * for each profile, with the paths a profile rules out removed
+ */
+struct Profile final {
+  /**
+   * some weapon launches projectiles
+   */
+  bool projectiles;
+  /**
+   * some weapon launches strike craft
+   */
+  bool hangars;
+  /**
+   * some point-defence weapon has projectiles or strike craft to shoot at
+   */
+  bool pointDefence;
+};
+
+/**
+ * the tightest profile that covers both fleets
+ */
+Profile profileOf(design::Fleet const &a, design::Fleet const &b) noexcept {
+  Profile profile = {
+      .projectiles = false,
+      .hangars = false,
+      .pointDefence = false,
+  };
+  bool pointDefence = false;
+  for (design::Fleet const *fleet : {&a, &b}) {
+    for (auto const &[ship, _] : fleet->ships) {
+      for (design::Section const &section : ship->sections) {
+        for (component::Weapon const *weapon : section.weapons) {
+          if (weapon->stats->type == component::Weapon::Type::PROJECTILE)
+            profile.projectiles = true;
+          if (weapon->stats->type == component::Weapon::Type::HANGAR)
+            profile.hangars = true;
+          if (weapon->stats->pointDefence) pointDefence = true;
         }
       }
     }
   }
-  // for each strike craft
-  for (entity::StrikeCraft &strikeCraft : firing.strikeCraft) {
+  profile.pointDefence =
+      pointDefence && (profile.projectiles || profile.hangars);
+  return profile;
+}
+
+/**
+ * shoot at one member of a salvo or squadron, returning true if a group was
+ * inserted at idx
+ *
+ * the members are identical, so a miss changes nothing and a kill just
+ * shrinks the group; only a member that's damaged but survives needs to be
+ * split off into a group of its own. It goes ahead of the rest of its group,
+ * so it's what the next shot at that spot hits - point defence keeps
+ * focusing on one craft, as it did when every craft was its own entity
+ */
+template <typename T>
+bool hitMember(vector<T> &groups, size_t idx,
+               component::Weapon::Stats const &weapon, design::Ship const &ship,
+               Rng &rng) noexcept {
+  if (groups[idx].count == 1) {
+    groups[idx].takeDamage(weapon, ship, rng);
+    return false;
+  }
+
+  T member = groups[idx].member();
+  if (!member.takeDamage(weapon, ship, rng)) return false;
+  --groups[idx].count;
+  if (member.hull <= 0.f) return false;
+  groups.insert(groups.begin() + static_cast<ptrdiff_t>(idx), member);
+  return true;
+}
+
+/**
+ * a group was inserted at idx; move shots still to be resolved at that kind
+ * of target past it along with the groups they were aimed at
+ */
+void shiftTargets(span<Volley> pending, size_t firstShot, Shot::Target kind,
+                  size_t idx) noexcept {
+  for (Volley &volley : pending) {
+    for (size_t shot = firstShot; shot < volley.shots.size(); ++shot)
+      if (volley.shots[shot].kind == kind && volley.shots[shot].target > idx)
+        ++volley.shots[shot].target;
+    firstShot = 0;
+  }
+}
+
+/**
+ * first phase of firing for a ship - fire its weapons and pick what they hit,
+ * without touching anything but the ship itself
+ */
+template <Profile profile>
+void aim(entity::Ship &ship, entity::Fleet const &targets, Rng const &rng,
+         Volley &volley) noexcept {
+  Rng shipRng = rng.stream(ship.id);
+
+  // regular weapons
+  for (entity::RegularWeapon &weapon : ship.regularWeapons) {
     // must have cooled down
-    if (strikeCraft.cooldown > 0.f) break;
+    if (weapon.cooldown > 0.f) continue;
 
     // find closest target in range
-    Entity *target = nullptr;
-    for (Entity &candidate : targets.ships) {
-      if (strikeCraft.inRange(candidate) &&
-          (!target ||
-           strikeCraft.rangeTo(candidate) < strikeCraft.rangeTo(*target))) {
+    Entity const *target = nullptr;
+    Shot::Target kind = Shot::Target::SHIP;
+    size_t targetIdx = 0;
+    auto consider = [&ship, &weapon, &target, &kind, &targetIdx](
+                        Entity const &candidate, Shot::Target candidateKind,
+                        size_t candidateIdx) {
+      if (ship.inRange(weapon, candidate) &&
+          (!target || ship.rangeTo(candidate) < ship.rangeTo(*target))) {
         target = &candidate;
+        kind = candidateKind;
+        targetIdx = candidateIdx;
       }
+    };
+    for (size_t candidate = 0; candidate < targets.ships.size(); ++candidate)
+      consider(targets.ships[candidate], Shot::Target::SHIP, candidate);
+
+    // also look at small targets for PD
+    if (profile.pointDefence && weapon.stats->pointDefence) {
+      for (size_t candidate = 0; candidate < targets.projectiles.size();
+           ++candidate)
+        consider(targets.projectiles[candidate], Shot::Target::SALVO,
+                 candidate);
+      for (size_t candidate = 0; candidate < targets.strikeCraft.size();
+           ++candidate)
+        consider(targets.strikeCraft[candidate], Shot::Target::SQUADRON,
+                 candidate);
     }
 
     // fire if we have a target
     if (target) {
-      strikeCraft.fire();
-      target->takeDamage(*strikeCraft.weapon, *strikeCraft.ship, rng);
+      Rng shotRng = shipRng.stream(weapon.slot).stream(weapon.shots);
+      weapon.fire();
+      volley.shots.push_back(Shot{
+          .target = targetIdx,
+          .weapon = weapon.stats,
+          .ship = ship.design,
+          .rng = shotRng,
+          .kind = kind,
+      });
+    }
+  }
+
+  // projectile weapons
+  if constexpr (profile.projectiles) {
+    for (entity::ProjectileWeapon &weapon : ship.projectileWeapons) {
+      // must have cooled down
+      if (weapon.cooldown > 0.f) continue;
+
+      // fire if there's a ship in range
+      if (any_of(targets.ships.begin(), targets.ships.end(),
+                 [&weapon, &ship](Entity const &target) {
+                   return ship.inRange(weapon, target);
+                 })) {
+        Rng shotRng = shipRng.stream(weapon.slot).stream(weapon.shots);
+        weapon.fire();
+        // TODO: add a target to projectiles and implement the retarget
+        // mechanic
+        // identical launchers on a ship fire together, so join their salvo
+        auto salvo = find_if(volley.projectiles.begin(),
+                             volley.projectiles.end(),
+                             [&weapon](entity::Projectile const &launched) {
+                               return launched.weapon == weapon.stats;
+                             });
+        if (salvo != volley.projectiles.end())
+          ++salvo->count;
+        else
+          volley.projectiles.emplace_back(*weapon.stats, ship, shotRng);
+      }
+    }
+  }
+
+  // hangars
+  if constexpr (profile.hangars) {
+    for (entity::HangarWeapon &weapon : ship.hangarWeapons) {
+      // must have craft available to deploy
+      if (weapon.unitsStored < 1.f) continue;
+
+      // deploy all strike craft as one squadron
+      uint64_t firstLaunch = weapon.shots;
+      size_t launched = 0;
+      while (weapon.unitsStored >= 1.f) {
+        weapon.fire();
+        ++launched;
+      }
+      volley.strikeCraft.emplace_back(*weapon.stats, ship,
+                                      shipRng.stream(weapon.slot),
+                                      firstLaunch, launched);
+    }
+  }
+}
+
+/**
+ * first phase of firing for a squadron
+ */
+void aim(entity::StrikeCraft &strikeCraft, entity::Fleet const &targets,
+         Volley &volley) noexcept {
+  // must have cooled down
+  if (strikeCraft.cooldown > 0.f) return;
+
+  // find closest target in range
+  Entity const *target = nullptr;
+  size_t targetIdx = 0;
+  for (size_t candidate = 0; candidate < targets.ships.size(); ++candidate) {
+    if (strikeCraft.inRange(targets.ships[candidate]) &&
+        (!target || strikeCraft.rangeTo(targets.ships[candidate]) <
+                        strikeCraft.rangeTo(*target))) {
+      target = &targets.ships[candidate];
+      targetIdx = candidate;
+    }
+  }
+
+  // every member fires at it if we have a target
+  if (target) {
+    for (size_t member = 0; member < strikeCraft.count; ++member)
+      volley.shots.push_back(Shot{
+          .target = targetIdx,
+          .weapon = strikeCraft.weapon,
+          .ship = strikeCraft.ship,
+          .rng = strikeCraft.memberRng(member).stream(strikeCraft.shots),
+          .kind = Shot::Target::SHIP,
+      });
+    strikeCraft.fire();
+  }
+}
+
+/**
+ * second phase of firing - launch and apply the first volley's damage in a
+ * fixed order, so the result doesn't depend on how the first phase was split
+ * between threads; the rest are the volleys still to be resolved
+ */
+template <Profile profile>
+void resolve(entity::Fleet &firing, entity::Fleet &targets,
+             span<Volley> volleys) noexcept {
+  Volley &volley = volleys.front();
+  if constexpr (profile.projectiles) {
+    firing.projectiles.insert(firing.projectiles.end(),
+                              make_move_iterator(volley.projectiles.begin()),
+                              make_move_iterator(volley.projectiles.end()));
+    volley.projectiles.clear();
+  }
+  if constexpr (profile.hangars) {
+    firing.strikeCraft.insert(firing.strikeCraft.end(),
+                              make_move_iterator(volley.strikeCraft.begin()),
+                              make_move_iterator(volley.strikeCraft.end()));
+    volley.strikeCraft.clear();
+  }
+  for (size_t shotIdx = 0; shotIdx < volley.shots.size(); ++shotIdx) {
+    Shot &shot = volley.shots[shotIdx];
+    // only point-defence shoots at anything but ships
+    Shot::Target kind = profile.pointDefence ? shot.kind : Shot::Target::SHIP;
+    switch (kind) {
+      case Shot::Target::SHIP: {
+        targets.ships[shot.target].takeDamage(*shot.weapon, *shot.ship,
+                                              shot.rng);
+        break;
+      }
+      case Shot::Target::SALVO: {
+        if (hitMember(targets.projectiles, shot.target, *shot.weapon,
+                      *shot.ship, shot.rng))
+          shiftTargets(volleys, shotIdx + 1, kind, shot.target);
+        break;
+      }
+      case Shot::Target::SQUADRON: {
+        if (hitMember(targets.strikeCraft, shot.target, *shot.weapon,
+                      *shot.ship, shot.rng))
+          shiftTargets(volleys, shotIdx + 1, kind, shot.target);
+        break;
+      }
     }
   }
+  volley.shots.clear();
 }
+}  // namespace
+
+template <Profile profile>
+void fireWeapons(entity::Fleet &firing, entity::Fleet &targets, Rng const &rng,
+                 FirePool &pool, vector<Volley> &volleys) noexcept {
+  // every ship fires, then every squadron, including any just launched
+  if (volleys.size() < firing.ships.size())
+    volleys.resize(firing.ships.size());
+  pool.forEach(firing.ships.size(),
+               [&firing, &targets, &rng, &volleys](size_t idx) {
+                 aim<profile>(firing.ships[idx], targets, rng, volleys[idx]);
+               });
+  for (size_t idx = 0; idx < firing.ships.size(); ++idx)
+    resolve<profile>(firing, targets,
+                     span(volleys).subspan(idx, firing.ships.size() - idx));
 
-void checkProjectiles(entity::Fleet &firing, entity::Fleet &targets,
-                      mt19937_64 &rng) noexcept {
+  if constexpr (!profile.hangars) return;
+  if (volleys.size() < firing.strikeCraft.size())
+    volleys.resize(firing.strikeCraft.size());
+  pool.forEach(firing.strikeCraft.size(),
+               [&firing, &targets, &volleys](size_t idx) {
+                 aim(firing.strikeCraft[idx], targets, volleys[idx]);
+               });
+  size_t squadrons = firing.strikeCraft.size();
+  for (size_t idx = 0; idx < squadrons; ++idx)
+    resolve<profile>(firing, targets,
+                     span(volleys).subspan(idx, squadrons - idx));
+}
+
+void checkProjectiles(entity::Fleet &firing, entity::Fleet &targets) noexcept {
   for (entity::Projectile &projectile : firing.projectiles) {
     // is there any ship within retarget range?
     if (!any_of(targets.ships.begin(), targets.ships.end(),
@@ -177,14 +650,18 @@ void checkProjectiles(entity::Fleet &firing, entity::Fleet &targets,
       }
     }
 
-    // hit if we have a target
+    // every member hits if we have a target
     if (target) {
-      projectile.hull = 0.f;  // destroy projectile
-      target->takeDamage(*projectile.weapon, *projectile.ship, rng);
+      projectile.hull = 0.f;  // destroy salvo
+      for (size_t member = 0; member < projectile.count; ++member) {
+        Rng hitRng = projectile.rng.stream(member);
+        target->takeDamage(*projectile.weapon, *projectile.ship, hitRng);
+      }
     }
   }
 }
 
+template <Profile profile>
 void applyDisengageAndDestruction(entity::Fleet &fleet) {
   copy_if(fleet.ships.begin(), fleet.ships.end(),
           back_inserter(fleet.disengaged),
@@ -195,18 +672,24 @@ void applyDisengageAndDestruction(entity::Fleet &fleet) {
   erase_if(fleet.ships, [](entity::Ship const &ship) {
     return ship.willDisengage || ship.hull <= 0.f;
   });
-  erase_if(fleet.projectiles,
-           [](Entity const &entity) { return entity.hull <= 0.f; });
-  erase_if(fleet.strikeCraft,
-           [](Entity const &entity) { return entity.hull <= 0.f; });
+  if constexpr (profile.projectiles)
+    erase_if(fleet.projectiles,
+             [](Entity const &entity) { return entity.hull <= 0.f; });
+  if constexpr (profile.hangars)
+    erase_if(fleet.strikeCraft,
+             [](Entity const &entity) { return entity.hull <= 0.f; });
 }
 
+template <Profile profile>
 void tick(entity::Fleet &fleet) {
   for (Entity &entity : fleet.ships) entity.tick();
-  for (Entity &entity : fleet.strikeCraft) entity.tick();
-  for (Entity &entity : fleet.projectiles) entity.tick();
+  if constexpr (profile.hangars)
+    for (Entity &entity : fleet.strikeCraft) entity.tick();
+  if constexpr (profile.projectiles)
+    for (Entity &entity : fleet.projectiles) entity.tick();
 }
 
+template <Profile profile>
 void move(entity::Fleet &moving, entity::Fleet const &opponent) {
   for (entity::Ship &ship : moving.ships) {
     // find closest ship
@@ -215,89 +698,178 @@ void move(entity::Fleet &moving, entity::Fleet const &opponent) {
       if (!target || ship.rangeTo(candidate) < ship.rangeTo(*target)) {
         target = &candidate;
       }
+    }
 
-      if (target) {
-        ship.moveToRange(*target, ship.design->preferredRange);
-      }
+    if (target) {
+      ship.moveToRange(*target, ship.design->preferredRange);
     }
   }
-  for (entity::StrikeCraft &strikeCraft : moving.strikeCraft) {
-    // find closest ship
-    Entity const *target = nullptr;
-    for (Entity const &candidate : opponent.ships) {
-      if (!target ||
-          strikeCraft.rangeTo(candidate) < strikeCraft.rangeTo(*target)) {
-        target = &candidate;
+  if constexpr (profile.hangars) {
+    for (entity::StrikeCraft &strikeCraft : moving.strikeCraft) {
+      // find closest ship
+      Entity const *target = nullptr;
+      for (Entity const &candidate : opponent.ships) {
+        if (!target ||
+            strikeCraft.rangeTo(candidate) < strikeCraft.rangeTo(*target)) {
+          target = &candidate;
+        }
       }
-    }
 
-    if (target) {
-      strikeCraft.moveToRange(*target, 0.f);
+      if (target) {
+        strikeCraft.moveToRange(*target, 0.f);
+      }
     }
   }
-  for (entity::Projectile &projectile : moving.projectiles) {
-    // find closest ship
-    Entity const *target = nullptr;
-    for (Entity const &candidate : opponent.ships) {
-      if (!target ||
-          projectile.rangeTo(candidate) < projectile.rangeTo(*target)) {
-        target = &candidate;
+  if constexpr (profile.projectiles) {
+    for (entity::Projectile &projectile : moving.projectiles) {
+      // find closest ship
+      Entity const *target = nullptr;
+      for (Entity const &candidate : opponent.ships) {
+        if (!target ||
+            projectile.rangeTo(candidate) < projectile.rangeTo(*target)) {
+          target = &candidate;
+        }
       }
-    }
 
-    if (target) {
-      projectile.moveToRange(*target, 0.f);
+      if (target) {
+        projectile.moveToRange(*target, 0.f);
+      }
     }
   }
 }
 
-pair<float, float> evaluate(design::Fleet const &aDesign,
-                            design::Fleet const &bDesign,
-                            EvaluationSettings const &settings) noexcept {
+namespace {
+/**
+ * add a loss event for every ship that left a fleet since the last call
+ */
+void record(vector<LossEvent> &events, size_t &destroyedRecorded,
+            size_t &disengagedRecorded, entity::Fleet const &fleet,
+            float time) {
+  for (; disengagedRecorded < fleet.disengaged.size(); ++disengagedRecorded)
+    events.push_back(LossEvent{
+        .time = time,
+        .cost = fleet.disengaged[disengagedRecorded].design->cost,
+        .destroyed = false,
+    });
+  for (; destroyedRecorded < fleet.destroyed.size(); ++destroyedRecorded)
+    events.push_back(LossEvent{
+        .time = time,
+        .cost = fleet.destroyed[destroyedRecorded].design->cost,
+        .destroyed = true,
+    });
+}
+
+/**
+ * run a fight on the given pool, optionally recording when each ship is lost
+ */
+template <Profile profile>
+EvaluationResult fight(design::Fleet const &aDesign,
+                       design::Fleet const &bDesign,
+                       EvaluationSettings const &settings,
+                       FightTimeline *timeline, FirePool &pool) noexcept {
   // instantiate fleets at max engagement range
   entity::Fleet a = entity::Fleet(aDesign, 0.f);
   entity::Fleet b = entity::Fleet(
       bDesign, fmaxf(engagementRange(aDesign), engagementRange(bDesign)));
 
-  // RNG for this evaluation run
-  mt19937_64 rng((random_device())());
+  // random streams for each side
+  Rng rng(settings.seed, settings.antithetic);
+  Rng aRng = rng.stream(0);
+  Rng bRng = rng.stream(1);
+
+  // firing state - each shooter's scratch space
+  vector<Volley> aVolleys;
+  vector<Volley> bVolleys;
+
+  // adaptive time step state - ticks left in which nothing can interact
+  size_t quiet = 0;
+  vector<int> aHeadings;
+  vector<int> bHeadings;
+
+  // early termination state - how much further each fleet could lose
+  bool truncated = false;
+  float aUncertainty = 0.f;
+  float bUncertainty = 0.f;
+
+  // timeline state - losses already recorded
+  size_t aDestroyedRecorded = 0;
+  size_t aDisengagedRecorded = 0;
+  size_t bDestroyedRecorded = 0;
+  size_t bDisengagedRecorded = 0;
 
   // for each tick
   bool moveOrder = false;
+  size_t tickCount = 0;
   for (float time = 0.f;
        time < settings.fightLengthLimit && !a.ships.empty() && !b.ships.empty();
-       time += TIME_QUANTUM) {
+       time += TIME_QUANTUM, ++tickCount) {
     if (settings.debugDump) {
       json aDumped = static_cast<json>(a);
       cerr << "// A @ " << time << ":\n" << aDumped.dump(2) << "\n";
       json bDumped = static_cast<json>(b);
       cerr << "// B @ " << time << ":\n" << bDumped.dump(2) << "\n";
     }
+
+    if (settings.earlyTerminationEpsilon > 0.f &&
+        tickCount % EARLY_TERMINATION_INTERVAL == 0) {
+      float remaining = settings.fightLengthLimit - time;
+      aUncertainty = maxFurtherLosses(a, maxDamage(b, remaining),
+                                      settings.withdrawMultiplier);
+      bUncertainty = maxFurtherLosses(b, maxDamage(a, remaining),
+                                      settings.withdrawMultiplier);
+      if (aUncertainty <= settings.earlyTerminationEpsilon &&
+          bUncertainty <= settings.earlyTerminationEpsilon) {
+        truncated = true;
+        break;
+      }
+    }
+
+    if (settings.adaptiveTimeStep) {
+      if (quiet == 0)
+        quiet = min(quietTicks(a, b, aHeadings), quietTicks(b, a, bHeadings));
+      if (quiet > 0) {
+        // nothing can fire, hit, or disengage, so only tick and move
+        --quiet;
+        tick<profile>(a);
+        tick<profile>(b);
+        drift(a, aHeadings);
+        drift(b, bHeadings);
+        continue;
+      }
+    }
     // fire weapons:
     //  - fire ship weapons
     //  - fire strike craft weapons
-    fireWeapons(a, b, rng);
-    fireWeapons(b, a, rng);
+    fireWeapons<profile>(a, b, aRng, pool, aVolleys);
+    fireWeapons<profile>(b, a, bRng, pool, bVolleys);
 
     // check for projectile hits
-    checkProjectiles(a, b, rng);
-    checkProjectiles(b, a, rng);
+    if constexpr (profile.projectiles) {
+      checkProjectiles(a, b);
+      checkProjectiles(b, a);
+    }
 
     // apply disengages and destruction
-    applyDisengageAndDestruction(a);
-    applyDisengageAndDestruction(b);
+    applyDisengageAndDestruction<profile>(a);
+    applyDisengageAndDestruction<profile>(b);
+    if (timeline) {
+      record(timeline->first, aDestroyedRecorded, aDisengagedRecorded, a,
+             time);
+      record(timeline->second, bDestroyedRecorded, bDisengagedRecorded, b,
+             time);
+    }
 
     // tick
-    tick(a);
-    tick(b);
+    tick<profile>(a);
+    tick<profile>(b);
 
     // move
     if (moveOrder) {
-      move(a, b);
-      move(b, a);
+      move<profile>(a, b);
+      move<profile>(b, a);
     } else {
-      move(b, a);
-      move(a, b);
+      move<profile>(b, a);
+      move<profile>(a, b);
     }
   }
 
@@ -308,23 +880,194 @@ pair<float, float> evaluate(design::Fleet const &aDesign,
     cerr << "// B @ end:\n" << bDumped.dump(2) << "\n";
   }
 
-  return pair(accumulate(a.destroyed.begin(), a.destroyed.end(), 0.f,
-                         [](float rsf, entity::Ship const &ship) {
-                           return rsf + ship.design->cost;
-                         }) +
-                  settings.withdrawMultiplier *
-                      accumulate(a.disengaged.begin(), a.disengaged.end(), 0.f,
-                                 [](float rsf, entity::Ship const &ship) {
-                                   return rsf + ship.design->cost;
-                                 }),
-              accumulate(b.destroyed.begin(), b.destroyed.end(), 0.f,
-                         [](float rsf, entity::Ship const &ship) {
-                           return rsf + ship.design->cost;
-                         }) +
-                  settings.withdrawMultiplier *
-                      accumulate(b.disengaged.begin(), b.disengaged.end(), 0.f,
-                                 [](float rsf, entity::Ship const &ship) {
-                                   return rsf + ship.design->cost;
-                                 }));
+  float aLosses = losses(a, settings.withdrawMultiplier);
+  float bLosses = losses(b, settings.withdrawMultiplier);
+  if (truncated) {
+    aLosses += aUncertainty / 2.f;
+    bLosses += bUncertainty / 2.f;
+  }
+  return EvaluationResult{
+      .firstLoss = aLosses,
+      .secondLoss = bLosses,
+      .truncated = truncated,
+  };
+}
+
+/**
+ * the profile at each index of FIGHTS, and the index of each profile
+ */
+constexpr Profile profileAt(size_t idx) noexcept {
+  return Profile{
+      .projectiles = (idx & 1) != 0,
+      .hangars = (idx & 2) != 0,
+      .pointDefence = (idx & 4) != 0,
+  };
+}
+size_t profileIndex(Profile const &profile) noexcept {
+  return (profile.projectiles ? 1 : 0) | (profile.hangars ? 2 : 0) |
+         (profile.pointDefence ? 4 : 0);
+}
+
+using Fight = EvaluationResult (*)(design::Fleet const &,
+                                   design::Fleet const &,
+                                   EvaluationSettings const &,
+                                   FightTimeline *, FirePool &) noexcept;
+template <size_t... idx>
+constexpr array<Fight, sizeof...(idx)> fights(index_sequence<idx...>) noexcept {
+  return {&fight<profileAt(idx)>...};
+}
+/**
+ * fight compiled for every profile
+ */
+constexpr array<Fight, 8> FIGHTS = fights(make_index_sequence<8>());
+
+/**
+ * run a fight with the loop compiled for the tightest profile covering both
+ * fleets
+ */
+EvaluationResult fight(design::Fleet const &aDesign,
+                       design::Fleet const &bDesign,
+                       EvaluationSettings const &settings,
+                       FightTimeline *timeline, FirePool &pool) noexcept {
+  return FIGHTS[profileIndex(profileOf(aDesign, bDesign))](
+      aDesign, bDesign, settings, timeline, pool);
+}
+
+}  // namespace
+
+EvaluationSettings replicate(EvaluationSettings const &settings,
+                             size_t idx) noexcept {
+  EvaluationSettings single = settings;
+  single.replicates = 1;
+  single.antitheticPairs = false;
+  if (settings.replicates <= 1) return single;
+
+  // each pair of antithetic replicates shares a seed
+  size_t seedIdx = settings.antitheticPairs ? idx / 2 : idx;
+  single.seed = Rng(settings.seed).stream(seedIdx)();
+  single.antithetic = settings.antitheticPairs && idx % 2 == 1;
+  return single;
+}
+
+EvaluationResult evaluate(design::Fleet const &a, design::Fleet const &b,
+                          EvaluationSettings const &settings) noexcept {
+  FirePool pool(settings.fireThreads);
+  return evaluate(a, b, settings, pool);
+}
+
+EvaluationResult evaluate(design::Fleet const &a, design::Fleet const &b,
+                          EvaluationSettings const &settings,
+                          FirePool &pool) noexcept {
+  if (settings.replicates <= 1)
+    return fight(a, b, replicate(settings, 0), nullptr, pool);
+
+  // replicates give the same results in lockstep, just faster
+  vector<EvaluationResult> results;
+  if (lockstepable(a, b) && !settings.debugDump &&
+      settings.earlyTerminationEpsilon <= 0.f) {
+    vector<EvaluationSettings> replicates;
+    for (size_t idx = 0; idx < settings.replicates; ++idx)
+      replicates.push_back(replicate(settings, idx));
+    results = fightLockstep(a, b,
+                            fmaxf(engagementRange(a), engagementRange(b)),
+                            replicates);
+  } else {
+    for (size_t idx = 0; idx < settings.replicates; ++idx)
+      results.push_back(fight(a, b, replicate(settings, idx), nullptr, pool));
+  }
+
+  EvaluationResult total = {
+      .firstLoss = 0.f,
+      .secondLoss = 0.f,
+      .truncated = false,
+  };
+  for (EvaluationResult const &result : results) {
+    total.firstLoss += result.firstLoss;
+    total.secondLoss += result.secondLoss;
+    total.truncated = total.truncated || result.truncated;
+  }
+  total.firstLoss /= static_cast<float>(settings.replicates);
+  total.secondLoss /= static_cast<float>(settings.replicates);
+  return total;
+}
+
+FightTimeline simulate(design::Fleet const &a, design::Fleet const &b,
+                       EvaluationSettings const &settings) noexcept {
+  FirePool pool(settings.fireThreads);
+  return simulate(a, b, settings, pool);
+}
+
+FightTimeline simulate(design::Fleet const &a, design::Fleet const &b,
+                       EvaluationSettings const &settings,
+                       FirePool &pool) noexcept {
+  EvaluationSettings untruncated = replicate(settings, 0);
+  untruncated.earlyTerminationEpsilon = 0.f;
+  FightTimeline timeline;
+  fight(a, b, untruncated, &timeline, pool);
+  return timeline;
+}
+
+EvaluationResult score(FightTimeline const &timeline,
+                       ScoringSettings const &scoring) noexcept {
+  // sum in the same order as losses does for the same result
+  auto lost = [&scoring](vector<LossEvent> const &events) {
+    float destroyed = 0.f;
+    float disengaged = 0.f;
+    for (LossEvent const &event : events) {
+      if (event.time >= scoring.fightLengthLimit) continue;
+      if (event.destroyed)
+        destroyed += event.cost;
+      else
+        disengaged += event.cost;
+    }
+    return destroyed + scoring.withdrawMultiplier * disengaged;
+  };
+  return EvaluationResult{
+      .firstLoss = lost(timeline.first),
+      .secondLoss = lost(timeline.second),
+      .truncated = false,
+  };
+}
+
+vector<EvaluationResult> evaluate(
+    design::Fleet const &a, design::Fleet const &b,
+    EvaluationSettings const &settings,
+    vector<ScoringSettings> const &scorings) noexcept {
+  FirePool pool(settings.fireThreads);
+  return evaluate(a, b, settings, scorings, pool);
+}
+
+vector<EvaluationResult> evaluate(design::Fleet const &a,
+                                  design::Fleet const &b,
+                                  EvaluationSettings const &settings,
+                                  vector<ScoringSettings> const &scorings,
+                                  FirePool &pool) noexcept {
+  EvaluationSettings longest = settings;
+  longest.fightLengthLimit =
+      accumulate(scorings.begin(), scorings.end(), 0.f,
+                 [](float rsf, ScoringSettings const &scoring) {
+                   return fmaxf(rsf, scoring.fightLengthLimit);
+                 });
+  size_t replicates = max(settings.replicates, size_t{1});
+
+  vector<EvaluationResult> results(scorings.size(),
+                                   EvaluationResult{
+                                       .firstLoss = 0.f,
+                                       .secondLoss = 0.f,
+                                       .truncated = false,
+                                   });
+  for (size_t idx = 0; idx < replicates; ++idx) {
+    FightTimeline timeline = simulate(a, b, replicate(longest, idx), pool);
+    for (size_t scoringIdx = 0; scoringIdx < scorings.size(); ++scoringIdx) {
+      EvaluationResult result = score(timeline, scorings[scoringIdx]);
+      results[scoringIdx].firstLoss += result.firstLoss;
+      results[scoringIdx].secondLoss += result.secondLoss;
+    }
+  }
+  for (EvaluationResult &result : results) {
+    result.firstLoss /= static_cast<float>(replicates);
+    result.secondLoss /= static_cast<float>(replicates);
+  }
+  return results;
 }
 }  // namespace athena2::model
@@ -20,25 +20,156 @@
 #ifndef ATHENA2_MODEL_EVALUATOR_H_
 #define ATHENA2_MODEL_EVALUATOR_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <utility>
+#include <vector>
 
 #include "model/design/fleet.h"
+#include "model/firePool.h"
+#include "model/isa.h"
 
 namespace athena2::model {
 struct EvaluationSettings {
   float fightLengthLimit;
   float withdrawMultiplier;
   bool debugDump;
+  /**
+   * skip firing and projectile checks for stretches of ticks where the fleets
+   * are provably out of range of each other; gives the same results as
+   * stepping every tick
+   */
+  bool adaptiveTimeStep;
+  /**
+   * stop the fight once neither fleet can lose more than this many
+   * mineral-equivalents before the fight length limit; zero to always fight
+   * to the end
+   */
+  float earlyTerminationEpsilon;
+  /**
+   * seed for the fight's random streams; every shot draws from a stream keyed
+   * by its side, ship, weapon and shot number, so fights with the same seed
+   * share random numbers wherever they fire the same shots
+   */
+  std::uint64_t seed;
+  /**
+   * draw the complement of every random number the seed would give
+   */
+  bool antithetic;
+  /**
+   * number of fights to average over, each with its own seed derived from
+   * seed
+   */
+  std::size_t replicates;
+  /**
+   * run replicates in pairs, the second of each pair antithetic to the first
+   */
+  bool antitheticPairs;
+  /**
+   * threads to pick targets on within a single fight, for very large fights;
+   * damage is still applied in a fixed order, so results don't depend on this
+   *
+   * evaluate and simulate start this many threads on each call unless they're
+   * given a pool to run on
+   */
+  std::size_t fireThreads;
+  /**
+   * instruction set to run the vectorized fight kernels with; defaults to
+   * detectIsa, and doesn't change results
+   */
+  Isa isa;
+};
+struct EvaluationResult {
+  float firstLoss;
+  float secondLoss;
+  /**
+   * true if the fight was stopped early; losses are then the midpoints of the
+   * range of possible final losses, and are within half of
+   * earlyTerminationEpsilon of the full fight's result
+   */
+  bool truncated;
+};
+/**
+ * the settings that only decide how a finished fight is scored
+ */
+struct ScoringSettings {
+  float fightLengthLimit;
+  float withdrawMultiplier;
+};
+/**
+ * a ship leaving a fight, either destroyed or disengaged
+ */
+struct LossEvent {
+  float time;
+  float cost;
+  bool destroyed;
+};
+/**
+ * every ship lost from each fleet over the course of a fight
+ */
+struct FightTimeline {
+  std::vector<LossEvent> first;
+  std::vector<LossEvent> second;
 };
 constexpr float TIME_QUANTUM = 0.1f;
 /**
- * score two fleets against each other
+ * ticks between checks for early termination
+ */
+constexpr size_t EARLY_TERMINATION_INTERVAL = 10;
+/**
+ * settings for a single fight, the idx'th of the replicates the settings ask
+ * for
+ */
+EvaluationSettings replicate(EvaluationSettings const &settings,
+                             std::size_t idx) noexcept;
+/**
+ * score two fleets against each other, averaged over the replicates
+ *
+ * result indicates the damage dealt to the first fleet and the damage dealt
+ * to the second fleet, in mineral-equivalents lost/withdrawn
+ */
+EvaluationResult evaluate(design::Fleet const &a, design::Fleet const &b,
+                          EvaluationSettings const &settings) noexcept;
+/**
+ * as evaluate, running on a pool of threads the caller keeps, which overrides
+ * settings.fireThreads
+ */
+EvaluationResult evaluate(design::Fleet const &a, design::Fleet const &b,
+                          EvaluationSettings const &settings,
+                          FirePool &pool) noexcept;
+/**
+ * simulate a fight between two fleets without scoring it
+ *
+ * early termination is never applied, since the timeline may be scored under
+ * other settings; replicates are ignored and a single fight is simulated
+ */
+FightTimeline simulate(design::Fleet const &a, design::Fleet const &b,
+                       EvaluationSettings const &settings) noexcept;
+FightTimeline simulate(design::Fleet const &a, design::Fleet const &b,
+                       EvaluationSettings const &settings,
+                       FirePool &pool) noexcept;
+/**
+ * score a simulated fight as if it had been cut off at the given fight length
+ * limit, which must be no longer than the one it was simulated with
+ */
+EvaluationResult score(FightTimeline const &timeline,
+                       ScoringSettings const &scoring) noexcept;
+/**
+ * score two fleets against each other under each of several scoring
+ * settings, using a single fight per replicate run to the longest fight length
+ * limit
  *
- * return value indicates the damage dealt to the first fleet and the damage
- * dealt to the second fleet, in mineral-equivalents lost/withdrawn
+ * each result is what evaluate would give for that fight length limit and
+ * withdraw multiplier, if it had drawn the same random numbers
  */
-std::pair<float, float> evaluate(design::Fleet const &a, design::Fleet const &b,
-                                 EvaluationSettings const &settings) noexcept;
+std::vector<EvaluationResult> evaluate(
+    design::Fleet const &a, design::Fleet const &b,
+    EvaluationSettings const &settings,
+    std::vector<ScoringSettings> const &scorings) noexcept;
+std::vector<EvaluationResult> evaluate(
+    design::Fleet const &a, design::Fleet const &b,
+    EvaluationSettings const &settings,
+    std::vector<ScoringSettings> const &scorings, FirePool &pool) noexcept;
 }  // namespace athena2::model
 
 #endif  // ATHENA2_MODEL_EVALUATOR_H_
@@ -0,0 +1,68 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/firePool.h"
+
+using namespace std;
+
+namespace athena2::model {
+FirePool::FirePool(size_t threads) noexcept
+    : workers(),
+      stateMutex(),
+      started(),
+      finished(),
+      job(nullptr),
+      call(nullptr),
+      count(0),
+      next(0),
+      active(0),
+      generation(0),
+      stopping(false) {
+  for (size_t idx = 1; idx < threads; ++idx)
+    workers.emplace_back([this]() { work(); });
+}
+FirePool::~FirePool() noexcept {
+  {
+    lock_guard lock(stateMutex);
+    stopping = true;
+  }
+  started.notify_all();
+  for (thread &worker : workers) worker.join();
+}
+void FirePool::claim() noexcept {
+  for (size_t idx = next++; idx < count; idx = next++) call(job, idx);
+}
+void FirePool::work() noexcept {
+  size_t seen = 0;
+  while (true) {
+    {
+      unique_lock lock(stateMutex);
+      started.wait(lock,
+                   [this, seen]() { return stopping || generation != seen; });
+      if (stopping) return;
+      seen = generation;
+    }
+    claim();
+    {
+      lock_guard lock(stateMutex);
+      if (--active == 0) finished.notify_one();
+    }
+  }
+}
+}  // namespace athena2::model
@@ -0,0 +1,96 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ATHENA2_MODEL_FIREPOOL_H_
+#define ATHENA2_MODEL_FIREPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace athena2::model {
+/**
+ * threads that share out a fight's per-tick work; the calling thread works
+ * too, so a pool of one thread has no workers and runs everything inline
+ *
+ * starting the threads is the expensive part, so anything that runs many
+ * fights should make one pool and pass it to each; a pool runs one fight at
+ * a time
+ */
+class FirePool final {
+ public:
+  explicit FirePool(std::size_t threads) noexcept;
+  FirePool(FirePool const &) noexcept = delete;
+  FirePool(FirePool &&) noexcept = delete;
+
+  ~FirePool() noexcept;
+
+  FirePool &operator=(FirePool const &) noexcept = delete;
+  FirePool &operator=(FirePool &&) noexcept = delete;
+
+  /**
+   * call f with each index below count, in no particular order, returning
+   * once every call is done
+   */
+  template <typename F>
+  void forEach(std::size_t count_, F const &f) noexcept {
+    if (workers.empty() || count_ <= 1) {
+      for (std::size_t idx = 0; idx < count_; ++idx) f(idx);
+      return;
+    }
+
+    {
+      std::lock_guard lock(stateMutex);
+      job = &f;
+      call = [](void const *erased, std::size_t idx) {
+        (*static_cast<F const *>(erased))(idx);
+      };
+      count = count_;
+      next = 0;
+      active = workers.size();
+      ++generation;
+    }
+    started.notify_all();
+    claim();
+    std::unique_lock lock(stateMutex);
+    finished.wait(lock, [this]() { return active == 0; });
+  }
+
+ private:
+  void claim() noexcept;
+  void work() noexcept;
+
+  std::vector<std::thread> workers;
+  std::mutex stateMutex;
+  std::condition_variable started;
+  std::condition_variable finished;
+  void const *job;
+  void (*call)(void const *, std::size_t);
+  std::size_t count;
+  std::atomic<std::size_t> next;
+  std::size_t active;
+  std::size_t generation;
+  bool stopping;
+};
+}  // namespace athena2::model
+
+#endif  // ATHENA2_MODEL_FIREPOOL_H_
@@ -0,0 +1,69 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/isa.h"
+
+#include <cstdlib>
+
+using namespace std;
+
+namespace athena2::model {
+Isa detectIsa() noexcept {
+  for (Isa isa : {Isa::AVX2, Isa::SSE4_2})
+    if (isaSupported(isa)) return isa;
+  return Isa::BASELINE;
+}
+bool isaSupported(Isa isa) noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  switch (isa) {
+    case Isa::BASELINE:
+      return true;
+    case Isa::SSE4_2:
+      return __builtin_cpu_supports("sse4.2");
+    case Isa::AVX2:
+      return __builtin_cpu_supports("avx2");
+    case Isa::AVX512:
+      return __builtin_cpu_supports("avx512f");
+  }
+  abort();  // invalid enum
+#else
+  return isa == Isa::BASELINE;
+#endif
+}
+optional<Isa> isaFromString(string const &name) noexcept {
+  if (name == "baseline") return Isa::BASELINE;
+  if (name == "sse4.2") return Isa::SSE4_2;
+  if (name == "avx2") return Isa::AVX2;
+  if (name == "avx512") return Isa::AVX512;
+  return nullopt;
+}
+string to_string(Isa isa) noexcept {
+  switch (isa) {
+    case Isa::BASELINE:
+      return "baseline";
+    case Isa::SSE4_2:
+      return "sse4.2";
+    case Isa::AVX2:
+      return "avx2";
+    case Isa::AVX512:
+      return "avx512";
+  }
+  abort();  // invalid enum
+}
+}  // namespace athena2::model
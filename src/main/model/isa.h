@@ -0,0 +1,62 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ATHENA2_MODEL_ISA_H_
+#define ATHENA2_MODEL_ISA_H_
+
+#include <optional>
+#include <string>
+
+namespace athena2::model {
+/**
+ * instruction sets the vectorized fight kernels are built for, from least to
+ * most capable
+ *
+ * the build turns off floating-point contraction, so avx512's fused
+ * multiply-add is never used and every variant gives bit-identical results
+ */
+enum class Isa {
+  BASELINE,
+  SSE4_2,
+  AVX2,
+  AVX512,
+};
+
+/**
+ * the instruction set to use when none is asked for - the most capable one
+ * this cpu supports, short of avx512
+ *
+ * lanes are eight floats wide, which avx2 already covers, and the avx512 build
+ * is slower on the machines it's been measured on, so it has to be asked for
+ */
+Isa detectIsa() noexcept;
+
+/**
+ * whether this cpu can run kernels built for the given instruction set
+ */
+bool isaSupported(Isa isa) noexcept;
+
+/**
+ * parse one of "baseline", "sse4.2", "avx2" or "avx512"
+ */
+std::optional<Isa> isaFromString(std::string const &name) noexcept;
+std::string to_string(Isa isa) noexcept;
+}  // namespace athena2::model
+
+#endif  // ATHENA2_MODEL_ISA_H_
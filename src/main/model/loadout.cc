@@ -0,0 +1,545 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/loadout.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+using namespace std;
+using namespace athena2::model::component;
+
+namespace athena2::model {
+namespace {
+/**
+ * bump whenever the stats or the cache file layout change
+ */
+constexpr uint64_t LOADOUT_FORMAT = 3;
+
+/**
+ * tag for auxiliary ids in the cache file
+ */
+constexpr ComponentId AUXILIARY = 0x8000;
+
+/**
+ * every stat that is better when bigger
+ */
+constexpr float LoadoutStats::*BENEFITS[] = {
+    &LoadoutStats::power,
+    &LoadoutStats::shieldDamage,
+    &LoadoutStats::armourDamage,
+    &LoadoutStats::hullDamage,
+    &LoadoutStats::shieldHealth,
+    &LoadoutStats::shieldRegen,
+    &LoadoutStats::armourHealth,
+    &LoadoutStats::hullHealth,
+    &LoadoutStats::sublightSpeedModifier,
+    &LoadoutStats::evasionModifier,
+    &LoadoutStats::armourHardeningBonus,
+    &LoadoutStats::hullRegenModifier,
+    &LoadoutStats::armourRegenModifier,
+    &LoadoutStats::shieldHealthModifier,
+    &LoadoutStats::shieldHardeningBonus,
+    &LoadoutStats::chanceToHitBonus,
+    &LoadoutStats::trackingBonus,
+    &LoadoutStats::disengageChancesBonus,
+};
+
+/**
+ * every stat that is better when bigger, and is the best of the components
+ * rather than their sum
+ */
+constexpr float LoadoutStats::*BEST_OF[] = {
+    &LoadoutStats::maxRange,
+    &LoadoutStats::tracking,
+};
+
+/**
+ * kind, size, and slot count - everything the fillings of a group depend on
+ */
+using GroupKey = tuple<bool, char, size_t>;
+
+/**
+ * stats summed in id order, so the same filling always gets the same stats
+ */
+LoadoutStats statsOf(SlotFilling const &filling) noexcept {
+  LoadoutStats result = {};
+  for (Weapon const *weapon : filling.weapons)
+    result += LoadoutStats::of(*weapon);
+  for (Utility const *utility : filling.utilities)
+    result += LoadoutStats::of(*utility);
+  for (Auxiliary const *auxiliary : filling.auxiliaries)
+    result += LoadoutStats::of(*auxiliary);
+  return result;
+}
+
+/**
+ * orders components by id; a lazily loaded set doesn't store them in id order
+ */
+struct ById final {
+  ComponentSet const &components;
+
+  template <typename T>
+  bool operator()(T const *lhs, T const *rhs) const noexcept {
+    return components.idOf(*lhs) < components.idOf(*rhs);
+  }
+  template <typename T>
+  bool operator()(vector<T const *> const &lhs,
+                  vector<T const *> const &rhs) const noexcept {
+    return lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                   rhs.end(), *this);
+  }
+};
+
+template <typename T>
+void insertSorted(vector<T const *> &sorted, T const *component,
+                  ComponentSet const &components) {
+  sorted.insert(upper_bound(sorted.begin(), sorted.end(), component,
+                            ById{components}),
+                component);
+}
+
+/**
+ * drop every filling that another one dominates, and repeated fillings
+ */
+vector<SlotFilling> paretoFront(vector<SlotFilling> &&fillings,
+                                ComponentSet const &components) noexcept {
+  auto contents = [](SlotFilling const &filling) {
+    return tie(filling.weapons, filling.utilities, filling.auxiliaries);
+  };
+  ById byId{components};
+  sort(fillings.begin(), fillings.end(),
+       [&byId](SlotFilling const &lhs, SlotFilling const &rhs) {
+         if (byId(lhs.weapons, rhs.weapons)) return true;
+         if (byId(rhs.weapons, lhs.weapons)) return false;
+         if (byId(lhs.utilities, rhs.utilities)) return true;
+         if (byId(rhs.utilities, lhs.utilities)) return false;
+         return byId(lhs.auxiliaries, rhs.auxiliaries);
+       });
+  fillings.erase(unique(fillings.begin(), fillings.end(),
+                        [&contents](SlotFilling const &lhs,
+                                    SlotFilling const &rhs) {
+                          return contents(lhs) == contents(rhs);
+                        }),
+                 fillings.end());
+
+  // a filling sorts after everything that dominates it, so it only needs
+  // checking against the front so far; float sums can tie, so ties are
+  // broken stat by stat
+  auto score = [](LoadoutStats const &stats) {
+    double result = -static_cast<double>(stats.cost);
+    for (float LoadoutStats::*stat : BENEFITS)
+      result += static_cast<double>(stats.*stat);
+    return result;
+  };
+  vector<pair<double, SlotFilling *>> order;
+  for (SlotFilling &filling : fillings)
+    order.emplace_back(score(filling.stats), &filling);
+  sort(order.begin(), order.end(),
+       [](pair<double, SlotFilling *> const &lhs,
+          pair<double, SlotFilling *> const &rhs) {
+         if (lhs.first > rhs.first) return true;
+         if (lhs.first < rhs.first) return false;
+         LoadoutStats const &lhsStats = lhs.second->stats;
+         LoadoutStats const &rhsStats = rhs.second->stats;
+         if (lhsStats.cost < rhsStats.cost) return true;
+         if (lhsStats.cost > rhsStats.cost) return false;
+         for (float LoadoutStats::*stat : BENEFITS) {
+           if (lhsStats.*stat > rhsStats.*stat) return true;
+           if (lhsStats.*stat < rhsStats.*stat) return false;
+         }
+         for (float LoadoutStats::*stat : BEST_OF) {
+           if (lhsStats.*stat > rhsStats.*stat) return true;
+           if (lhsStats.*stat < rhsStats.*stat) return false;
+         }
+         return lhsStats.minRange < rhsStats.minRange;
+       });
+
+  vector<SlotFilling> front;
+  for (auto const &[_, filling] : order) {
+    if (none_of(front.begin(), front.end(),
+                [filling](SlotFilling const &other) {
+                  return other.stats.dominates(filling->stats);
+                }))
+      front.push_back(move(*filling));
+  }
+  return front;
+}
+
+ComponentFilter tiersOf(LoadoutSettings const &settings) noexcept {
+  return ComponentFilter{
+      .minTier = settings.minTier,
+      .maxTier = settings.maxTier,
+  };
+}
+
+/**
+ * nondominated fillings of some slots, adding one slot at a time
+ *
+ * a dominated filling stays dominated when the same component is added to
+ * both, so it's safe to prune after every slot
+ */
+SlotGroup enumerateGroup(GroupKey const &key, ComponentSet const &components,
+                         LoadoutSettings const &settings) noexcept {
+  auto const &[weapon, size, slots] = key;
+
+  // single components that fit
+  ComponentFilter filter = tiersOf(settings);
+  filter.size = string(1, size);
+  vector<SlotFilling> options;
+  if (weapon) {
+    for (Weapon const &option : components.weaponView(filter))
+      options.push_back(SlotFilling{{&option}, {}, {}, {}});
+  } else {
+    for (Utility const &option : components.utilityView(filter))
+      options.push_back(SlotFilling{{}, {&option}, {}, {}});
+    for (Auxiliary const &option : components.auxiliaryView(filter))
+      options.push_back(SlotFilling{{}, {}, {&option}, {}});
+  }
+  for (SlotFilling &option : options) option.stats = statsOf(option);
+
+  SlotGroup group = {
+      .weapon = weapon,
+      .size = size,
+      .slots = slots,
+      .options = options.size(),
+      .enumerated = false,
+      .fillings = {},
+  };
+  if (settings.maxCandidates != 0 &&
+      group.candidates() > static_cast<double>(settings.maxCandidates))
+    return group;
+
+  vector<SlotFilling> front = {SlotFilling{}};
+  for (size_t slot = 0; slot < slots; ++slot) {
+    // leaving the slot empty keeps every filling so far
+    vector<SlotFilling> next = front;
+    for (SlotFilling const &filling : front) {
+      for (SlotFilling const &option : options) {
+        SlotFilling extended = filling;
+        for (Weapon const *component : option.weapons)
+          insertSorted(extended.weapons, component, components);
+        for (Utility const *component : option.utilities)
+          insertSorted(extended.utilities, component, components);
+        for (Auxiliary const *component : option.auxiliaries)
+          insertSorted(extended.auxiliaries, component, components);
+        extended.stats += option.stats;
+        next.push_back(move(extended));
+      }
+    }
+    front = paretoFront(move(next), components);
+  }
+  for (SlotFilling &filling : front) filling.stats = statsOf(filling);
+
+  group.enumerated = true;
+  group.fillings = move(front);
+  return group;
+}
+
+/**
+ * the groups of slots in a section, in a fixed order
+ */
+vector<GroupKey> groupsOf(component::Section const &section) noexcept {
+  vector<GroupKey> result;
+  auto addGroups = [&result](bool weapon, string const &slots) {
+    // slot strings are sorted, so each size is one run
+    for (auto it = slots.begin(); it != slots.end();) {
+      auto end = find_if(it, slots.end(), [it](char c) { return c != *it; });
+      result.emplace_back(weapon, *it, static_cast<size_t>(end - it));
+      it = end;
+    }
+  };
+  addGroups(true, section.weaponSlots);
+  addGroups(false, section.utilitySlots);
+  return result;
+}
+
+vector<GroupKey> uniqueGroups(ComponentSet const &components,
+                              LoadoutSettings const &settings) noexcept {
+  vector<GroupKey> result;
+  for (component::Section const &section :
+       components.sectionView(tiersOf(settings))) {
+    vector<GroupKey> groups = groupsOf(section);
+    result.insert(result.end(), groups.begin(), groups.end());
+  }
+  sort(result.begin(), result.end());
+  result.erase(unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+vector<SectionLoadouts> assemble(ComponentSet const &components,
+                                 LoadoutSettings const &settings,
+                                 vector<GroupKey> const &keys,
+                                 vector<SlotGroup> const &groups) noexcept {
+  vector<SectionLoadouts> result;
+  for (component::Section const &section :
+       components.sectionView(tiersOf(settings))) {
+    SectionLoadouts loadouts = {.section = &section, .groups = {}};
+    for (GroupKey const &key : groupsOf(section))
+      loadouts.groups.push_back(groups[static_cast<size_t>(
+          lower_bound(keys.begin(), keys.end(), key) - keys.begin())]);
+    result.push_back(move(loadouts));
+  }
+  return result;
+}
+
+vector<SlotGroup> enumerateGroups(vector<GroupKey> const &keys,
+                                  ComponentSet const &components,
+                                  LoadoutSettings const &settings) noexcept {
+  vector<SlotGroup> groups(keys.size());
+
+  // groups differ wildly in size, so workers take them one at a time
+  atomic<size_t> next = 0;
+  auto work = [&keys, &groups, &next, &components, &settings]() {
+    for (size_t idx = next++; idx < keys.size(); idx = next++)
+      groups[idx] = enumerateGroup(keys[idx], components, settings);
+  };
+  size_t threadCount = settings.threads;
+  if (threadCount == 0)
+    threadCount = max(size_t{1}, size_t{thread::hardware_concurrency()});
+  vector<thread> workers;
+  for (size_t idx = 1; idx < min(threadCount, keys.size()); ++idx)
+    workers.emplace_back(work);
+  work();
+  for (thread &worker : workers) worker.join();
+  return groups;
+}
+
+template <typename T>
+void writeValue(ofstream &out, T value) {
+  out.write(reinterpret_cast<char const *>(&value), sizeof(value));
+}
+template <typename T>
+bool readValue(ifstream &in, T &value) {
+  return static_cast<bool>(
+      in.read(reinterpret_cast<char *>(&value), sizeof(value)));
+}
+
+/**
+ * read back cached groups; nothing if the cache is missing, stale, or broken
+ */
+optional<vector<SlotGroup>> readGroups(string const &filename,
+                                       vector<GroupKey> const &keys,
+                                       ComponentSet const &components,
+                                       LoadoutSettings const &settings) {
+  ifstream in(filename, ios::binary);
+  uint64_t format;
+  uint64_t fingerprint;
+  uint64_t maxCandidates;
+  uint32_t minTier;
+  uint32_t maxTier;
+  uint64_t count;
+  if (!readValue(in, format) || format != LOADOUT_FORMAT ||
+      !readValue(in, fingerprint) || fingerprint != components.fingerprint() ||
+      !readValue(in, maxCandidates) ||
+      maxCandidates != settings.maxCandidates || !readValue(in, minTier) ||
+      minTier != settings.minTier || !readValue(in, maxTier) ||
+      maxTier != settings.maxTier || !readValue(in, count) ||
+      count != keys.size())
+    return nullopt;
+
+  vector<SlotGroup> groups;
+  for (GroupKey const &key : keys) {
+    auto const &[weapon, size, slots] = key;
+    uint64_t options;
+    uint8_t enumerated;
+    uint64_t fillingCount;
+    if (!readValue(in, options) || !readValue(in, enumerated) ||
+        !readValue(in, fillingCount))
+      return nullopt;
+
+    SlotGroup group = {
+        .weapon = weapon,
+        .size = size,
+        .slots = slots,
+        .options = options,
+        .enumerated = enumerated != 0,
+        .fillings = {},
+    };
+    for (uint64_t fillingIdx = 0; fillingIdx < fillingCount; ++fillingIdx) {
+      uint16_t componentCount;
+      if (!readValue(in, componentCount)) return nullopt;
+      SlotFilling filling = {};
+      for (uint16_t componentIdx = 0; componentIdx < componentCount;
+           ++componentIdx) {
+        ComponentId id;
+        if (!readValue(in, id)) return nullopt;
+        if (weapon) {
+          Weapon const *component = components.getWeapon(id);
+          if (!component) return nullopt;
+          filling.weapons.push_back(component);
+        } else if (id & AUXILIARY) {
+          Auxiliary const *component = components.getAuxiliary(
+              static_cast<ComponentId>(id & ~AUXILIARY));
+          if (!component) return nullopt;
+          filling.auxiliaries.push_back(component);
+        } else {
+          Utility const *component = components.getUtility(id);
+          if (!component) return nullopt;
+          filling.utilities.push_back(component);
+        }
+      }
+      filling.stats = statsOf(filling);
+      group.fillings.push_back(move(filling));
+    }
+    groups.push_back(move(group));
+  }
+  return groups;
+}
+
+void writeGroups(string const &filename, vector<SlotGroup> const &groups,
+                 ComponentSet const &components,
+                 LoadoutSettings const &settings, EvalContext &ctx) {
+  ofstream out(filename, ios::binary | ios::trunc);
+  if (!out) ctx.error("could not open file");
+
+  writeValue(out, LOADOUT_FORMAT);
+  writeValue(out, components.fingerprint());
+  writeValue(out, settings.maxCandidates);
+  writeValue(out, uint32_t{settings.minTier});
+  writeValue(out, uint32_t{settings.maxTier});
+  writeValue(out, uint64_t{groups.size()});
+  for (SlotGroup const &group : groups) {
+    writeValue(out, uint64_t{group.options});
+    writeValue(out, static_cast<uint8_t>(group.enumerated));
+    writeValue(out, uint64_t{group.fillings.size()});
+    for (SlotFilling const &filling : group.fillings) {
+      writeValue(out, static_cast<uint16_t>(filling.weapons.size() +
+                                            filling.utilities.size() +
+                                            filling.auxiliaries.size()));
+      for (Weapon const *weapon : filling.weapons)
+        writeValue(out, components.idOf(*weapon));
+      for (Utility const *utility : filling.utilities)
+        writeValue(out, components.idOf(*utility));
+      for (Auxiliary const *auxiliary : filling.auxiliaries)
+        writeValue(out, static_cast<ComponentId>(
+                            components.idOf(*auxiliary) | AUXILIARY));
+    }
+  }
+  out.flush();
+  if (!out) ctx.error("could not write file");
+}
+}  // namespace
+
+LoadoutStats LoadoutStats::of(Weapon const &weapon) noexcept {
+  Weapon::Stats const &stats = *weapon.stats;
+  float damage = stats.cooldown > 0.f
+                     ? (stats.minDamage + stats.maxDamage) / 2.f *
+                           stats.accuracy / stats.cooldown
+                     : 0.f;
+  if (stats.type == Weapon::Type::HANGAR)
+    damage *= stats.data.hangarWeapon.unitsPerHangar;
+  LoadoutStats result = {};
+  result.power = weapon.power;
+  result.cost = weapon.cost;
+  result.shieldDamage = damage * (1.f + stats.shieldDamageModifier);
+  result.armourDamage = damage * (1.f + stats.armourDamageModifier);
+  result.hullDamage = damage * (1.f + stats.hullDamageModifier);
+  result.maxRange = stats.maxRange;
+  result.tracking = stats.tracking;
+  result.minRange = stats.minRange;
+  return result;
+}
+LoadoutStats LoadoutStats::of(Utility const &utility) noexcept {
+  LoadoutStats result = {};
+  result.power = utility.power;
+  result.cost = utility.cost;
+  result.shieldHealth = utility.shieldHealth;
+  result.shieldRegen = utility.shieldRegen;
+  result.armourHealth = utility.armourHealth;
+  result.hullHealth = utility.hullHealth;
+  return result;
+}
+LoadoutStats LoadoutStats::of(Auxiliary const &auxiliary) noexcept {
+  LoadoutStats result = {};
+  result.power = auxiliary.power;
+  result.cost = auxiliary.cost;
+  result.sublightSpeedModifier = auxiliary.sublightSpeedModifier;
+  result.evasionModifier = auxiliary.evasionModifier;
+  result.armourHardeningBonus = auxiliary.armourHardeningBonus;
+  result.hullRegenModifier = auxiliary.hullRegenModifier;
+  result.armourRegenModifier = auxiliary.armourRegenModifier;
+  result.shieldHealthModifier = auxiliary.shieldHealthModifier;
+  result.shieldHardeningBonus = auxiliary.shieldHardeningBonus;
+  result.chanceToHitBonus = auxiliary.chanceToHitBonus;
+  result.trackingBonus = auxiliary.trackingBonus;
+  result.disengageChancesBonus = auxiliary.disengageChancesBonus;
+  return result;
+}
+LoadoutStats &LoadoutStats::operator+=(LoadoutStats const &other) noexcept {
+  cost += other.cost;
+  for (float LoadoutStats::*stat : BENEFITS) this->*stat += other.*stat;
+  for (float LoadoutStats::*stat : BEST_OF)
+    this->*stat = fmaxf(this->*stat, other.*stat);
+  minRange = fminf(minRange, other.minRange);
+  return *this;
+}
+bool LoadoutStats::dominates(LoadoutStats const &other) const noexcept {
+  if (cost > other.cost) return false;
+  bool better = cost < other.cost;
+  for (float LoadoutStats::*stat : BENEFITS) {
+    if (this->*stat < other.*stat) return false;
+    better = better || this->*stat > other.*stat;
+  }
+  for (float LoadoutStats::*stat : BEST_OF) {
+    if (this->*stat < other.*stat) return false;
+    better = better || this->*stat > other.*stat;
+  }
+  if (minRange > other.minRange) return false;
+  return better || minRange < other.minRange;
+}
+
+double SlotGroup::candidates() const noexcept {
+  // multisets of up to slots items from options, or with the empty slot as
+  // one more option, multisets of exactly slots items
+  double result = 1.0;
+  for (size_t idx = 1; idx <= slots; ++idx)
+    result = result * static_cast<double>(options + idx) /
+             static_cast<double>(idx);
+  return round(result);
+}
+
+vector<SectionLoadouts> enumerateLoadouts(
+    ComponentSet const &components, LoadoutSettings const &settings) noexcept {
+  vector<GroupKey> keys = uniqueGroups(components, settings);
+  return assemble(components, settings, keys,
+                  enumerateGroups(keys, components, settings));
+}
+vector<SectionLoadouts> enumerateLoadouts(ComponentSet const &components,
+                                          LoadoutSettings const &settings,
+                                          string const &cacheFile,
+                                          EvalContext &ctx) {
+  auto _ = ctx.push(cacheFile);
+  vector<GroupKey> keys = uniqueGroups(components, settings);
+  optional<vector<SlotGroup>> groups =
+      readGroups(cacheFile, keys, components, settings);
+  if (!groups) {
+    groups = enumerateGroups(keys, components, settings);
+    writeGroups(cacheFile, *groups, components, settings, ctx);
+  }
+  return assemble(components, settings, keys, *groups);
+}
+}  // namespace athena2::model
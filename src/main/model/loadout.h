@@ -0,0 +1,153 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ATHENA2_MODEL_LOADOUT_H_
+#define ATHENA2_MODEL_LOADOUT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "dsl.h"
+#include "model/component/auxiliary.h"
+#include "model/component/componentSet.h"
+#include "model/component/section.h"
+#include "model/component/utility.h"
+#include "model/component/weapon.h"
+
+namespace athena2::model {
+/**
+ * stats of some slots' contents that add up over components
+ *
+ * damage is the expected damage per day against each layer, with the
+ * weapon's modifier for that layer as a bonus. Range and tracking don't add
+ * up; they're the best of any weapon, since range decides who fires first.
+ * Every stat but cost and minRange is better when bigger
+ */
+struct LoadoutStats final {
+  float power;
+  float cost;
+  float shieldDamage;
+  float armourDamage;
+  float hullDamage;
+  float shieldHealth;
+  float shieldRegen;
+  float armourHealth;
+  float hullHealth;
+  float sublightSpeedModifier;
+  float evasionModifier;
+  float armourHardeningBonus;
+  float hullRegenModifier;
+  float armourRegenModifier;
+  float shieldHealthModifier;
+  float shieldHardeningBonus;
+  float chanceToHitBonus;
+  float trackingBonus;
+  float disengageChancesBonus;
+  float maxRange;
+  float tracking;
+  float minRange = std::numeric_limits<float>::infinity();
+
+  static LoadoutStats of(component::Weapon const &) noexcept;
+  static LoadoutStats of(component::Utility const &) noexcept;
+  static LoadoutStats of(component::Auxiliary const &) noexcept;
+
+  LoadoutStats &operator+=(LoadoutStats const &) noexcept;
+
+  /**
+   * true if this is no worse in every stat and better in at least one
+   */
+  bool dominates(LoadoutStats const &) const noexcept;
+};
+/**
+ * contents of the slots of one size in a section; components are in id order
+ */
+struct SlotFilling final {
+  std::vector<component::Weapon const *> weapons;
+  std::vector<component::Utility const *> utilities;
+  std::vector<component::Auxiliary const *> auxiliaries;
+  LoadoutStats stats;
+};
+/**
+ * the weapon or utility slots of one size in a section, and the fillings of
+ * them that no other filling dominates
+ *
+ * the stats add up, so a filling of a section that picks a dominated filling
+ * for any of its groups is itself dominated
+ */
+struct SlotGroup final {
+  bool weapon;
+  char size;
+  std::size_t slots;
+  /**
+   * components that fit one of these slots
+   */
+  std::size_t options;
+  /**
+   * false if there were too many candidates to enumerate; there are then no
+   * fillings, and each slot has to be chosen separately
+   */
+  bool enumerated;
+  std::vector<SlotFilling> fillings;
+
+  /**
+   * number of fillings before pruning, including leaving slots empty
+   */
+  double candidates() const noexcept;
+};
+struct SectionLoadouts final {
+  component::Section const *section;
+  std::vector<SlotGroup> groups;
+};
+struct LoadoutSettings final {
+  /**
+   * worker threads to enumerate with; zero to use every core
+   */
+  std::size_t threads;
+  /**
+   * groups with more candidate fillings than this aren't enumerated; zero for
+   * no limit
+   */
+  std::uint64_t maxCandidates;
+  /**
+   * inclusive range of tiers to draw sections and components from
+   */
+  unsigned minTier;
+  unsigned maxTier;
+};
+/**
+ * enumerate the nondominated fillings of every section's slots
+ *
+ * groups with the same kind, size, and slot count are only enumerated once
+ */
+std::vector<SectionLoadouts> enumerateLoadouts(
+    component::ComponentSet const &, LoadoutSettings const &) noexcept;
+/**
+ * enumerate loadouts, reusing the results saved in a cache file if it was
+ * written with the same components, candidate limit, and tiers, and saving
+ * them if not
+ */
+std::vector<SectionLoadouts> enumerateLoadouts(
+    component::ComponentSet const &, LoadoutSettings const &,
+    std::string const &cacheFile, EvalContext &ctx);
+}  // namespace athena2::model
+
+#endif  // ATHENA2_MODEL_LOADOUT_H_
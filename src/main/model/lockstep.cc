@@ -0,0 +1,463 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/lockstep.h"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+
+#include "model/entity/damage.h"
+#include "model/entity/ship.h"
+#include "model/isa.h"
+#include "model/rng.h"
+
+using namespace std;
+using namespace athena2::model::design;
+
+namespace athena2::model {
+namespace {
+template <typename T>
+using Lanes = array<T, LOCKSTEP_LANES>;
+
+struct WeaponLanes final {
+  component::Weapon::Stats const *stats;
+  float maxRange;
+  Lanes<float> cooldown;
+  Lanes<uint64_t> shots;
+};
+
+struct ShipLanes final {
+  design::Ship const *design;
+  size_t id;
+  vector<WeaponLanes> weapons;
+  Lanes<float> hull;
+  Lanes<float> armour;
+  Lanes<float> shields;
+  Lanes<float> position;
+  Lanes<float> disengageChancesRemaining;
+  Lanes<bool> willDisengage;
+  Lanes<bool> alive;
+};
+
+struct FleetLanes final {
+  FleetLanes(design::Fleet const &design, float position) noexcept
+      : ships(), remaining{}, destroyed{}, disengaged{} {
+    for (auto const &[ship, count] : design.ships) {
+      for (size_t idx = 0; idx < count; ++idx) {
+        ShipLanes lanes = {};
+        lanes.design = ship.get();
+        lanes.id = ships.size();
+        for (design::Section const &section : ship->sections)
+          for (component::Weapon const *weapon : section.weapons)
+            lanes.weapons.push_back(WeaponLanes{
+                .stats = weapon->stats,
+                .maxRange = weapon->stats->maxRange *
+                            (1.f + ship->weaponsRangeModifier),
+                .cooldown = {},
+                .shots = {},
+            });
+        lanes.hull.fill(ship->hullHealth);
+        lanes.armour.fill(ship->armourHealth);
+        lanes.shields.fill(ship->shieldHealth);
+        lanes.position.fill(position);
+        lanes.disengageChancesRemaining.fill(ship->disengageChances);
+        lanes.willDisengage.fill(false);
+        lanes.alive.fill(true);
+        ships.push_back(move(lanes));
+      }
+    }
+    remaining.fill(ships.size());
+  }
+
+  vector<ShipLanes> ships;
+  /**
+   * ships that haven't been destroyed or disengaged yet
+   */
+  Lanes<size_t> remaining;
+  /**
+   * running totals of the cost of ships lost, summed in the same order as
+   * losses does
+   */
+  Lanes<float> destroyed;
+  Lanes<float> disengaged;
+};
+
+/**
+ * a hit waiting to go through its target's defences
+ */
+struct PendingHit final {
+  size_t target;
+  entity::Hit hit;
+  Rng rng;
+};
+
+/**
+ * closest ship in each lane that passes the filter, or -1 if there's none;
+ * ties go to the first ship, as they do when fighting alone
+ */
+template <typename InRange>
+[[gnu::always_inline]] inline Lanes<ptrdiff_t> closest(
+    Lanes<float> const &position, vector<ShipLanes> const &candidates,
+    InRange const &inRange) noexcept {
+  Lanes<ptrdiff_t> target;
+  target.fill(-1);
+  Lanes<float> best = {};
+  for (size_t idx = 0; idx < candidates.size(); ++idx) {
+    ShipLanes const &candidate = candidates[idx];
+    for (size_t lane = 0; lane < LOCKSTEP_LANES; ++lane) {
+      float range = fabsf(position[lane] - candidate.position[lane]);
+      bool better = candidate.alive[lane] && inRange(range) &&
+                    (target[lane] < 0 || range < best[lane]);
+      target[lane] = better ? static_cast<ptrdiff_t>(idx) : target[lane];
+      best[lane] = better ? range : best[lane];
+    }
+  }
+  return target;
+}
+
+/**
+ * fire every ready weapon, leaving the hits in each lane in the order they
+ * were fired
+ */
+[[gnu::always_inline]] inline void fireWeapons(
+    FleetLanes &firing, FleetLanes const &targets, vector<Rng> const &rngs,
+    Lanes<bool> const &active, Lanes<vector<PendingHit>> &hits) noexcept {
+  for (ShipLanes &ship : firing.ships) {
+    for (size_t idx = 0; idx < ship.weapons.size(); ++idx) {
+      WeaponLanes &weapon = ship.weapons[idx];
+      float minRange = weapon.stats->minRange;
+      float maxRange = weapon.maxRange;
+      Lanes<ptrdiff_t> target =
+          closest(ship.position, targets.ships,
+                  [minRange, maxRange](float range) {
+                    return minRange <= range && range <= maxRange;
+                  });
+      for (size_t lane = 0; lane < LOCKSTEP_LANES; ++lane) {
+        if (!active[lane] || !ship.alive[lane] ||
+            weapon.cooldown[lane] > 0.f || target[lane] < 0)
+          continue;
+        Rng shotRng =
+            rngs[lane].stream(ship.id).stream(idx).stream(weapon.shots[lane]);
+        ++weapon.shots[lane];
+        weapon.cooldown[lane] = weapon.stats->cooldown;
+        size_t targetIdx = static_cast<size_t>(target[lane]);
+        optional<entity::Hit> hit =
+            entity::rollHit(*weapon.stats, *ship.design,
+                            targets.ships[targetIdx].design->evasion, shotRng);
+        if (hit)
+          hits[lane].push_back(PendingHit{
+              .target = targetIdx,
+              .hit = *hit,
+              .rng = shotRng,
+          });
+      }
+    }
+  }
+}
+
+/**
+ * put the hits from a round of firing through their targets' defences
+ *
+ * the nth hit in every lane goes in the same block, so each block has at most
+ * one hit per target and hits on a target are taken in the order they were
+ * fired
+ */
+[[gnu::always_inline]] inline void resolveHits(
+    FleetLanes &targets, Lanes<vector<PendingHit>> &hits) noexcept {
+  size_t blocks = 0;
+  for (vector<PendingHit> const &laneHits : hits)
+    blocks = max(blocks, laneHits.size());
+
+  for (size_t block = 0; block < blocks; ++block) {
+    entity::HitBlock<LOCKSTEP_LANES> hitBlock = {};
+    entity::DefenceBlock<LOCKSTEP_LANES> defences = {};
+    for (size_t lane = 0; lane < LOCKSTEP_LANES; ++lane) {
+      if (block >= hits[lane].size()) continue;
+      entity::Hit const &hit = hits[lane][block].hit;
+      ShipLanes const &target = targets.ships[hits[lane][block].target];
+      hitBlock.damage[lane] = hit.damage;
+      hitBlock.shieldSkipModifier[lane] = hit.shieldSkipModifier;
+      hitBlock.shieldDamageModifier[lane] = hit.shieldDamageModifier;
+      hitBlock.armourSkipModifier[lane] = hit.armourSkipModifier;
+      hitBlock.armourDamageModifier[lane] = hit.armourDamageModifier;
+      hitBlock.hullDamageModifier[lane] = hit.hullDamageModifier;
+      defences.shields[lane] = target.shields[lane];
+      defences.armour[lane] = target.armour[lane];
+      defences.hull[lane] = target.hull[lane];
+      defences.shieldHardening[lane] = target.design->shieldHardening;
+      defences.armourHardening[lane] = target.design->armourHardening;
+    }
+
+    Lanes<float> hullDamage;
+    Lanes<bool> survives;
+    entity::penetrate(hitBlock, defences, hullDamage, survives);
+
+    for (size_t lane = 0; lane < LOCKSTEP_LANES; ++lane) {
+      if (block >= hits[lane].size()) continue;
+      PendingHit &pending = hits[lane][block];
+      ShipLanes &target = targets.ships[pending.target];
+      target.shields[lane] = defences.shields[lane];
+      target.armour[lane] = defences.armour[lane];
+      target.hull[lane] = defences.hull[lane];
+      if (survives[lane])
+        entity::Ship::checkRetreat(*target.design, target.hull[lane],
+                                   hullDamage[lane],
+                                   target.disengageChancesRemaining[lane],
+                                   target.willDisengage[lane], pending.rng);
+    }
+  }
+
+  for (vector<PendingHit> &laneHits : hits) laneHits.clear();
+}
+
+[[gnu::always_inline]] inline void applyDisengageAndDestruction(
+    FleetLanes &fleet, Lanes<bool> const &active) noexcept {
+  for (ShipLanes &ship : fleet.ships) {
+    for (size_t lane = 0; lane < LOCKSTEP_LANES; ++lane) {
+      if (!active[lane] || !ship.alive[lane]) continue;
+      bool destroyed = ship.hull[lane] <= 0.f;
+      if (ship.willDisengage[lane])
+        fleet.disengaged[lane] += ship.design->cost;
+      if (destroyed) fleet.destroyed[lane] += ship.design->cost;
+      if (ship.willDisengage[lane] || destroyed) {
+        ship.alive[lane] = false;
+        --fleet.remaining[lane];
+      }
+    }
+  }
+}
+
+/**
+ * every lane is ticked, since a lane that's done or a ship that's gone is
+ * never looked at again
+ */
+[[gnu::always_inline]] inline void tick(FleetLanes &fleet) noexcept {
+  for (ShipLanes &ship : fleet.ships) {
+    design::Ship const &design = *ship.design;
+    for (size_t lane = 0; lane < LOCKSTEP_LANES; ++lane) {
+      ship.hull[lane] =
+          fminf(design.hullHealth, ship.hull[lane] + design.hullRegen);
+      ship.armour[lane] =
+          fminf(design.armourHealth, ship.armour[lane] + design.armourRegen);
+      ship.shields[lane] =
+          fminf(design.shieldHealth, ship.shields[lane] + design.shieldRegen);
+    }
+    for (WeaponLanes &weapon : ship.weapons) {
+      for (size_t lane = 0; lane < LOCKSTEP_LANES; ++lane) {
+        float cooldown = weapon.cooldown[lane];
+        float health = ship.hull[lane] / design.hullHealth;
+        float cooled = cooldown - TIME_QUANTUM *
+                                      (1.f + design.fireRateModifier) *
+                                      (0.5f + 0.5f * health);
+        weapon.cooldown[lane] = cooldown > 0.f ? cooled : cooldown;
+      }
+    }
+  }
+}
+
+[[gnu::always_inline]] inline void move(FleetLanes &moving,
+                                       FleetLanes const &opponent,
+                                       Lanes<bool> const &active) noexcept {
+  for (ShipLanes &ship : moving.ships) {
+    Lanes<ptrdiff_t> target =
+        closest(ship.position, opponent.ships, [](float) { return true; });
+    float range = ship.design->preferredRange;
+    float step = TIME_QUANTUM * ship.design->speed;
+    for (size_t lane = 0; lane < LOCKSTEP_LANES; ++lane) {
+      bool moves = active[lane] && ship.alive[lane] && target[lane] >= 0;
+      float targetPosition =
+          opponent.ships[moves ? static_cast<size_t>(target[lane]) : 0]
+              .position[lane];
+      float position = ship.position[lane];
+      // as in Entity::moveToRange
+      float smallerCandidate = targetPosition - range;
+      float largerCandidate = targetPosition + range;
+      float destination = fabsf(position - smallerCandidate) <
+                                  fabsf(position - largerCandidate)
+                              ? smallerCandidate
+                              : largerCandidate;
+      float moved = fabsf(destination - position) <= step ? destination
+                    : destination < position            ? position - step
+                                                        : position + step;
+      ship.position[lane] = moves ? moved : position;
+    }
+  }
+}
+
+/**
+ * up to LOCKSTEP_LANES replicates being fought side by side
+ */
+struct Block final {
+  Block(design::Fleet const &aDesign, design::Fleet const &bDesign,
+        float distance, EvaluationSettings const *replicates_,
+        size_t lanes_) noexcept
+      : a(aDesign, 0.f),
+        b(bDesign, distance),
+        aRngs(),
+        bRngs(),
+        replicates(replicates_),
+        lanes(lanes_),
+        active{},
+        hits() {
+    for (size_t lane = 0; lane < lanes; ++lane) {
+      Rng rng(replicates[lane].seed, replicates[lane].antithetic);
+      aRngs.push_back(rng.stream(0));
+      bRngs.push_back(rng.stream(1));
+      active[lane] = true;
+    }
+  }
+  Block(Block const &) noexcept = delete;
+  Block(Block &&) noexcept = delete;
+
+  ~Block() noexcept = default;
+
+  Block &operator=(Block const &) noexcept = delete;
+  Block &operator=(Block &&) noexcept = delete;
+
+  FleetLanes a;
+  FleetLanes b;
+  /**
+   * random streams for each side
+   */
+  vector<Rng> aRngs;
+  vector<Rng> bRngs;
+  EvaluationSettings const *replicates;
+  size_t lanes;
+  /**
+   * which lanes are still fighting
+   */
+  Lanes<bool> active;
+  Lanes<vector<PendingHit>> hits;
+};
+
+/**
+ * the same steps as fighting alone, over every lane at once
+ *
+ * inlined into one copy per instruction set, along with the kernels it calls
+ */
+[[gnu::always_inline]] inline void fight(Block &block) noexcept {
+  FleetLanes &a = block.a;
+  FleetLanes &b = block.b;
+  Lanes<bool> &active = block.active;
+  for (float time = 0.f;; time += TIME_QUANTUM) {
+    bool any = false;
+    for (size_t lane = 0; lane < block.lanes; ++lane) {
+      active[lane] = active[lane] &&
+                     time < block.replicates[lane].fightLengthLimit &&
+                     a.remaining[lane] > 0 && b.remaining[lane] > 0;
+      any = any || active[lane];
+    }
+    if (!any) break;
+
+    fireWeapons(a, b, block.aRngs, active, block.hits);
+    resolveHits(b, block.hits);
+    fireWeapons(b, a, block.bRngs, active, block.hits);
+    resolveHits(a, block.hits);
+
+    applyDisengageAndDestruction(a, active);
+    applyDisengageAndDestruction(b, active);
+
+    tick(a);
+    tick(b);
+
+    move(b, a, active);
+    move(a, b, active);
+  }
+}
+
+void fightBaseline(Block &block) noexcept { fight(block); }
+#if defined(__x86_64__) || defined(__i386__)
+[[gnu::target("sse4.2")]] void fightSse42(Block &block) noexcept {
+  fight(block);
+}
+[[gnu::target("avx2")]] void fightAvx2(Block &block) noexcept {
+  fight(block);
+}
+[[gnu::target("avx512f")]] void fightAvx512(Block &block) noexcept {
+  fight(block);
+}
+#endif
+
+using FightBlock = void (*)(Block &) noexcept;
+
+/**
+ * the copy of fight built for the given instruction set
+ */
+FightBlock fightFor(Isa isa) noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  switch (isa) {
+    case Isa::BASELINE:
+      return fightBaseline;
+    case Isa::SSE4_2:
+      return fightSse42;
+    case Isa::AVX2:
+      return fightAvx2;
+    case Isa::AVX512:
+      return fightAvx512;
+  }
+  abort();  // invalid enum
+#else
+  return fightBaseline;
+#endif
+}
+}  // namespace
+
+bool lockstepable(design::Fleet const &a, design::Fleet const &b) noexcept {
+  auto regularOnly = [](design::Fleet const &fleet) {
+    for (auto const &[ship, _] : fleet.ships)
+      for (design::Section const &section : ship->sections)
+        for (component::Weapon const *weapon : section.weapons)
+          if (weapon->stats->type != component::Weapon::Type::REGULAR)
+            return false;
+    return true;
+  };
+  return regularOnly(a) && regularOnly(b);
+}
+
+vector<EvaluationResult> fightLockstep(
+    design::Fleet const &aDesign, design::Fleet const &bDesign, float distance,
+    vector<EvaluationSettings> const &replicates) noexcept {
+  vector<EvaluationResult> results;
+  results.reserve(replicates.size());
+  if (replicates.empty()) return results;
+
+  FightBlock fightBlock = fightFor(replicates.front().isa);
+  for (size_t first = 0; first < replicates.size();
+       first += LOCKSTEP_LANES) {
+    Block block(aDesign, bDesign, distance, &replicates[first],
+                min(LOCKSTEP_LANES, replicates.size() - first));
+    fightBlock(block);
+
+    for (size_t lane = 0; lane < block.lanes; ++lane) {
+      float withdrawMultiplier = replicates[first + lane].withdrawMultiplier;
+      results.push_back(EvaluationResult{
+          .firstLoss = block.a.destroyed[lane] +
+                       withdrawMultiplier * block.a.disengaged[lane],
+          .secondLoss = block.b.destroyed[lane] +
+                        withdrawMultiplier * block.b.disengaged[lane],
+          .truncated = false,
+      });
+    }
+  }
+  return results;
+}
+}  // namespace athena2::model
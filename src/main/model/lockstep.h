@@ -0,0 +1,55 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ATHENA2_MODEL_LOCKSTEP_H_
+#define ATHENA2_MODEL_LOCKSTEP_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "model/design/fleet.h"
+#include "model/evaluator.h"
+
+namespace athena2::model {
+/**
+ * replicates fought side by side; every per-ship value is stored once per
+ * lane, so the tick, regen, cooldown and movement math runs over all lanes at
+ * once
+ */
+constexpr std::size_t LOCKSTEP_LANES = 8;
+
+/**
+ * true if two fleets can be fought in lockstep - every replicate has to keep
+ * the same entities, so neither fleet may launch projectiles or strike craft
+ */
+bool lockstepable(design::Fleet const &a, design::Fleet const &b) noexcept;
+
+/**
+ * fight each of the given single-replicate settings, starting the fleets the
+ * given distance apart
+ *
+ * each result is bit-identical to fighting that replicate alone; debug dumps
+ * and early termination aren't supported
+ */
+std::vector<EvaluationResult> fightLockstep(
+    design::Fleet const &a, design::Fleet const &b, float distance,
+    std::vector<EvaluationSettings> const &replicates) noexcept;
+}  // namespace athena2::model
+
+#endif  // ATHENA2_MODEL_LOCKSTEP_H_
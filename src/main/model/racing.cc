@@ -0,0 +1,133 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/racing.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+namespace athena2::model {
+RacingResult race(vector<design::Fleet const *> const &candidates,
+                  vector<design::Fleet const *> const &opponents,
+                  EvaluationSettings const &settings,
+                  RacingSettings const &racing, FirePool &pool,
+                  ResultCache *cache) noexcept {
+  auto start = chrono::steady_clock::now();
+  size_t totalFights = 0;
+  auto outOfBudget = [&]() {
+    if (racing.fightBudget > 0 && totalFights >= racing.fightBudget)
+      return true;
+    return racing.timeBudget > 0.f &&
+           chrono::duration<float>(chrono::steady_clock::now() - start)
+                   .count() >= racing.timeBudget;
+  };
+
+  // k'th fight against an opponent uses the k'th replicate seed
+  EvaluationSettings replicates = settings;
+  replicates.replicates = numeric_limits<size_t>::max();
+
+  RacingResult result = {
+      .ranking = {},
+      .scores = vector<float>(candidates.size(), 0.f),
+      .fights = vector<size_t>(candidates.size(), 0),
+      .stoppedEarly = false,
+  };
+  vector<float> totals(candidates.size(), 0.f);
+  // fights run against each opponent, per candidate
+  vector<size_t> rounds(candidates.size(), 0);
+
+  vector<size_t> survivors(candidates.size());
+  for (size_t idx = 0; idx < candidates.size(); ++idx) survivors[idx] = idx;
+  // candidates dropped so far, worst first
+  vector<size_t> dropped;
+
+  // rounds needed to get down to one candidate
+  size_t roundCount = 1;
+  if (candidates.size() > 1 && racing.keepFraction < 1.f)
+    roundCount = static_cast<size_t>(
+        ceilf(logf(static_cast<float>(candidates.size())) /
+              -logf(racing.keepFraction)));
+
+  auto byScore = [&result](size_t lhs, size_t rhs) {
+    return result.scores[lhs] > result.scores[rhs];
+  };
+
+  size_t target = max(racing.initialFights, size_t{1});
+  while (!result.stoppedEarly) {
+    // fights per opponent for the survivors this round
+    if (racing.fightBudget > 0) {
+      size_t pairings = survivors.size() * max(opponents.size(), size_t{1});
+      target = max(target, racing.fightBudget / roundCount / pairings);
+    }
+
+    for (size_t candidate : survivors) {
+      for (; rounds[candidate] < target; ++rounds[candidate]) {
+        for (design::Fleet const *opponent : opponents) {
+          if (opponent == candidates[candidate]) continue;
+          if (outOfBudget()) {
+            result.stoppedEarly = true;
+            break;
+          }
+          EvaluationResult fight =
+              evaluate(*candidates[candidate], *opponent,
+                       replicate(replicates, rounds[candidate]), cache, pool);
+          totals[candidate] += fight.secondLoss - fight.firstLoss;
+          ++result.fights[candidate];
+          ++totalFights;
+        }
+        if (result.stoppedEarly) break;
+      }
+      if (result.fights[candidate] > 0)
+        result.scores[candidate] =
+            totals[candidate] / static_cast<float>(result.fights[candidate]);
+      if (result.stoppedEarly) break;
+    }
+
+    // only candidates that finished the round are ranked on it; the rest
+    // keep their order from the round before
+    auto unfinished =
+        stable_partition(survivors.begin(), survivors.end(),
+                         [&](size_t idx) { return rounds[idx] >= target; });
+    sort(survivors.begin(), unfinished, byScore);
+    if (result.stoppedEarly || survivors.size() <= 1) break;
+
+    // drop the worst, keeping at least one
+    size_t kept = max(
+        size_t{1},
+        static_cast<size_t>(
+            ceilf(static_cast<float>(survivors.size()) * racing.keepFraction)));
+    if (kept == survivors.size()) --kept;
+    dropped.insert(dropped.end(), survivors.rbegin(),
+                   survivors.rend() - static_cast<ptrdiff_t>(kept));
+    survivors.resize(kept);
+
+    target = static_cast<size_t>(
+        ceilf(static_cast<float>(target) / racing.keepFraction));
+  }
+
+  result.ranking = survivors;
+  result.ranking.insert(result.ranking.end(), dropped.rbegin(),
+                        dropped.rend());
+  return result;
+}
+}  // namespace athena2::model
@@ -0,0 +1,93 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ATHENA2_MODEL_RACING_H_
+#define ATHENA2_MODEL_RACING_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "model/cache.h"
+#include "model/design/fleet.h"
+#include "model/evaluator.h"
+#include "model/firePool.h"
+
+namespace athena2::model {
+struct RacingSettings {
+  /**
+   * fights against each opponent for every candidate in the first round
+   */
+  std::size_t initialFights;
+  /**
+   * fraction of candidates kept after each round; the fights per opponent
+   * grow by the inverse of this each round
+   */
+  float keepFraction;
+  /**
+   * stop once this many fights have been run in total; zero for no limit
+   *
+   * the budget is also split evenly between the rounds, so later rounds give
+   * their survivors more fights than they otherwise would
+   */
+  std::size_t fightBudget;
+  /**
+   * stop once this many seconds have passed; zero for no limit
+   */
+  float timeBudget;
+};
+struct RacingResult {
+  /**
+   * indices of the candidates, best first; candidates dropped in a later
+   * round rank above those dropped earlier, and if a budget runs out
+   * mid-round, survivors that didn't finish it rank below those that did, in
+   * their order from the round before
+   */
+  std::vector<std::size_t> ranking;
+  /**
+   * mean over each candidate's fights of the opponent's losses less the
+   * candidate's losses
+   */
+  std::vector<float> scores;
+  /**
+   * fights run by each candidate
+   */
+  std::vector<std::size_t> fights;
+  /**
+   * true if a budget ran out before a single candidate was left
+   */
+  bool stoppedEarly;
+};
+/**
+ * rank candidate fleets against a pool of opponents by successive halving
+ *
+ * every candidate fights each opponent a few times, the worst are dropped,
+ * and the survivors fight more, until one is left or the budget runs out;
+ * the k'th fight of every candidate against an opponent uses the same seed,
+ * so candidates are compared on common random numbers. A candidate never
+ * fights itself, settings.replicates is ignored, and fights are looked up in
+ * the cache if one is given. Every fight runs on the given pool
+ */
+RacingResult race(std::vector<design::Fleet const *> const &candidates,
+                  std::vector<design::Fleet const *> const &opponents,
+                  EvaluationSettings const &settings,
+                  RacingSettings const &racing, FirePool &pool,
+                  ResultCache *cache = nullptr) noexcept;
+}  // namespace athena2::model
+
+#endif  // ATHENA2_MODEL_RACING_H_
@@ -0,0 +1,167 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/rating.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <utility>
+
+#include "util/json.h"
+
+using namespace std;
+using namespace athena2::util;
+using namespace nlohmann;
+
+namespace athena2::model {
+namespace {
+constexpr float Q = numbers::ln10_v<float> / 400.f;
+
+/**
+ * Glicko's attenuation of a result against an uncertainly-rated opponent
+ */
+float attenuation(float deviation) noexcept {
+  return 1.f / sqrtf(1.f + 3.f * Q * Q * deviation * deviation /
+                               (numbers::pi_v<float> * numbers::pi_v<float>));
+}
+
+/**
+ * rating after a single game scoring score (1 for a win, 0 for a loss)
+ * against an opponent
+ */
+Rating update(Rating const &rating, Rating const &opponent,
+              float score) noexcept {
+  float g = attenuation(opponent.deviation);
+  float expected =
+      1.f / (1.f + powf(10.f, -g * (rating.rating - opponent.rating) / 400.f));
+  float inverseVariance = Q * Q * g * g * expected * (1.f - expected);
+  float precision =
+      1.f / (rating.deviation * rating.deviation) + inverseVariance;
+  return Rating{
+      .rating = rating.rating + Q / precision * g * (score - expected),
+      .deviation = sqrtf(1.f / precision),
+      .fights = rating.fights + 1,
+      .opponents = rating.opponents,
+  };
+}
+}  // namespace
+
+Rating Rating::fromJson(json const &data, EvalContext &ctx) {
+  Rating rating = {
+      .rating = checkFloat(data, "rating", ctx),
+      .deviation = checkFloat(data, "deviation", ctx),
+      .fights = checkUnsignedInteger(data, "fights", ctx),
+      .opponents = {},
+  };
+  // tables written before opponents were recorded have none
+  json const *opponentsData = checkMaybeObject(data, "opponents", ctx);
+  checkFields(data, {"rating", "deviation", "fights", "opponents"}, ctx);
+  if (rating.deviation <= 0.f) {
+    auto _ = ctx.push("deviation");
+    ctx.error("value must be positive");
+  }
+  if (opponentsData) {
+    auto _ = ctx.push("opponents");
+    for (auto const &[key, val] : opponentsData->items())
+      rating.opponents.emplace(key,
+                               checkUnsignedInteger(*opponentsData, key, ctx));
+  }
+  return rating;
+}
+void to_json(json &j, Rating const &r) noexcept {
+  j = json{{"rating", r.rating},
+           {"deviation", r.deviation},
+           {"fights", r.fights},
+           {"opponents", r.opponents}};
+}
+
+size_t swissRounds(size_t fleets) noexcept {
+  size_t rounds = 1;
+  while ((size_t{1} << rounds) < fleets) ++rounds;
+  return rounds;
+}
+
+void playSwiss(vector<design::Fleet const *> const &fleets,
+               vector<Rating> &ratings, EvaluationSettings const &settings,
+               size_t rounds, FirePool &pool, ResultCache *cache) noexcept {
+  // the k'th fight between two fleets uses the k'th replicate seed
+  EvaluationSettings replicates = settings;
+  replicates.replicates = numeric_limits<size_t>::max();
+  auto played = [&fleets, &ratings](size_t first, size_t second) {
+    auto found = ratings[first].opponents.find(fleets[second]->name);
+    return found == ratings[first].opponents.end() ? size_t{0}
+                                                   : found->second;
+  };
+
+  vector<size_t> order(fleets.size());
+  for (size_t round = 0; round < rounds; ++round) {
+    for (size_t idx = 0; idx < order.size(); ++idx) order[idx] = idx;
+    stable_sort(order.begin(), order.end(), [&ratings](size_t lhs, size_t rhs) {
+      return ratings[lhs].rating > ratings[rhs].rating;
+    });
+
+    // pair each fleet with the nearest-rated unpaired fleet it hasn't
+    // played, or failing that, the nearest-rated unpaired fleet
+    vector<pair<size_t, size_t>> pairings;
+    vector<bool> paired(fleets.size(), false);
+    for (size_t idx = 0; idx < order.size(); ++idx) {
+      size_t first = order[idx];
+      if (paired[first]) continue;
+      size_t fallback = order.size();
+      size_t chosen = order.size();
+      for (size_t candidateIdx = idx + 1; candidateIdx < order.size();
+           ++candidateIdx) {
+        size_t candidate = order[candidateIdx];
+        if (paired[candidate]) continue;
+        if (fallback == order.size()) fallback = candidate;
+        if (played(first, candidate) == 0) {
+          chosen = candidate;
+          break;
+        }
+      }
+      if (chosen == order.size()) chosen = fallback;
+      // the last fleet left over sits this round out
+      if (chosen == order.size()) break;
+      paired[first] = paired[chosen] = true;
+      pairings.emplace_back(first, chosen);
+    }
+
+    // ratings within a round are updated from the ratings before the round
+    vector<Rating> before = ratings;
+    for (auto const &[first, second] : pairings) {
+      EvaluationResult result =
+          evaluate(*fleets[first], *fleets[second],
+                   replicate(replicates, played(first, second)), cache, pool);
+      float score;
+      if (result.firstLoss < result.secondLoss)
+        score = 1.f;
+      else if (result.secondLoss < result.firstLoss)
+        score = 0.f;
+      else
+        score = 0.5f;
+      ratings[first] = update(before[first], before[second], score);
+      ratings[second] = update(before[second], before[first], 1.f - score);
+      ++ratings[first].opponents[fleets[second]->name];
+      ++ratings[second].opponents[fleets[first]->name];
+    }
+  }
+}
+}  // namespace athena2::model
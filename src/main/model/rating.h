@@ -0,0 +1,84 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ATHENA2_MODEL_RATING_H_
+#define ATHENA2_MODEL_RATING_H_
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "dsl.h"
+#include "model/cache.h"
+#include "model/design/fleet.h"
+#include "model/evaluator.h"
+#include "model/firePool.h"
+#include "nlohmann/json.hpp"
+
+namespace athena2::model {
+/**
+ * Glicko rating of a fleet; ratings are comparable between fleets rated in
+ * the same table, whenever they were added to it
+ */
+struct Rating {
+  static Rating fromJson(nlohmann::json const &, EvalContext &);
+
+  float rating;
+  /**
+   * standard deviation of the rating; shrinks as the fleet fights
+   */
+  float deviation;
+  std::size_t fights;
+  /**
+   * fights against each opponent, by name; the k'th fight between two fleets
+   * uses the k'th replicate seed, so rating again never replays a fight
+   */
+  std::map<std::string, std::size_t> opponents;
+};
+void to_json(nlohmann::json &, Rating const &) noexcept;
+/**
+ * rating of a fleet that has never fought
+ */
+inline Rating const INITIAL_RATING = {
+    .rating = 1500.f,
+    .deviation = 350.f,
+    .fights = 0,
+    .opponents = {},
+};
+/**
+ * rounds of a Swiss tournament needed to rank this many fleets
+ */
+std::size_t swissRounds(std::size_t fleets) noexcept;
+/**
+ * play a Swiss tournament, updating each fleet's rating after every round
+ *
+ * each round, fleets are paired with the nearest-rated fleet they haven't yet
+ * played, in this tournament or an earlier one, so n fleets need only n / 2
+ * fights per round; each fight is seeded from the number of fights its pair
+ * has already had, settings.replicates is ignored, and fights are looked up
+ * in the cache if one is given. Every fight runs on the given pool
+ */
+void playSwiss(std::vector<design::Fleet const *> const &fleets,
+               std::vector<Rating> &ratings,
+               EvaluationSettings const &settings, std::size_t rounds,
+               FirePool &pool, ResultCache *cache = nullptr) noexcept;
+}  // namespace athena2::model
+
+#endif  // ATHENA2_MODEL_RATING_H_
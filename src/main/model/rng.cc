@@ -0,0 +1,67 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/rng.h"
+
+#include <cmath>
+
+using namespace std;
+
+namespace athena2::model {
+namespace {
+constexpr uint64_t GOLDEN_GAMMA = 0x9e3779b97f4a7c15;
+constexpr float FLOAT_UNIT = 0x1p-24f;
+
+uint64_t mix(uint64_t z) noexcept {
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+  return z ^ (z >> 31);
+}
+}  // namespace
+
+Rng::Rng(uint64_t seed_, bool antithetic_) noexcept
+    : seed(seed_), state(seed_), antithetic(antithetic_) {}
+Rng Rng::stream(uint64_t key) const noexcept {
+  return Rng(mix(seed ^ mix(key + GOLDEN_GAMMA)), antithetic);
+}
+Rng::result_type Rng::operator()() noexcept {
+  state += GOLDEN_GAMMA;
+  uint64_t result = mix(state);
+  return antithetic ? ~result : result;
+}
+float Rng::uniform() noexcept {
+  return static_cast<float>((*this)() >> 40) * FLOAT_UNIT;
+}
+float Rng::uniform(float min, float max) noexcept {
+  // scaling can round up to max, so pull that back to the float just below
+  float result = min + (max - min) * uniform();
+  return result < max ? result : nextafterf(max, min);
+}
+bool Rng::bernoulli(float probability) noexcept {
+  return uniform() < probability;
+}
+void Rng::fill(span<float> block) noexcept {
+  uint64_t mask = antithetic ? ~uint64_t{0} : 0;
+  for (size_t idx = 0; idx < block.size(); ++idx) {
+    uint64_t result = mix(state + (idx + 1) * GOLDEN_GAMMA) ^ mask;
+    block[idx] = static_cast<float>(result >> 40) * FLOAT_UNIT;
+  }
+  state += block.size() * GOLDEN_GAMMA;
+}
+}  // namespace athena2::model
@@ -0,0 +1,89 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ATHENA2_MODEL_RNG_H_
+#define ATHENA2_MODEL_RNG_H_
+
+#include <cstdint>
+#include <limits>
+#include <span>
+
+namespace athena2::model {
+/**
+ * splitmix64 random number generator that can be split into independent
+ * streams by key
+ *
+ * keying streams by what draws from them (side, ship, weapon, shot) lets two
+ * fights against the same opponent share random numbers wherever they fire
+ * the same shots (common random numbers); an antithetic generator returns the
+ * complement of every number its twin returns
+ *
+ * the nth number depends only on the seed and n, so blocks of numbers can be
+ * generated without a dependency from one to the next
+ */
+class Rng final {
+ public:
+  using result_type = std::uint64_t;
+
+  explicit Rng(std::uint64_t seed, bool antithetic = false) noexcept;
+  Rng(Rng const &) noexcept = default;
+  Rng(Rng &&) noexcept = default;
+
+  ~Rng() noexcept = default;
+
+  Rng &operator=(Rng const &) noexcept = default;
+  Rng &operator=(Rng &&) noexcept = default;
+
+  /**
+   * the stream for the given key; independent of this generator's position
+   */
+  Rng stream(std::uint64_t key) const noexcept;
+
+  static constexpr result_type min() noexcept { return 0; }
+  static constexpr result_type max() noexcept {
+    return std::numeric_limits<result_type>::max();
+  }
+  result_type operator()() noexcept;
+
+  /**
+   * uniform float in [0, 1), from the top 24 bits of the next number
+   */
+  float uniform() noexcept;
+  /**
+   * uniform float in [min, max), or min if they're equal
+   */
+  float uniform(float min, float max) noexcept;
+  /**
+   * true with the given probability; probabilities past 0 or 1 are clamped
+   */
+  bool bernoulli(float probability) noexcept;
+  /**
+   * fill a block with the next uniform floats, exactly as calling uniform
+   * once for each would
+   */
+  void fill(std::span<float> block) noexcept;
+
+ private:
+  std::uint64_t seed;
+  std::uint64_t state;
+  bool antithetic;
+};
+}  // namespace athena2::model
+
+#endif  // ATHENA2_MODEL_RNG_H_
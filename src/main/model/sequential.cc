@@ -0,0 +1,168 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/sequential.h"
+
+#include <cmath>
+
+using namespace std;
+
+namespace athena2::model {
+namespace {
+/**
+ * state of one sequential probability ratio test
+ */
+enum class Decision {
+  CONTINUE,
+  ACCEPT_NULL,
+  ACCEPT_ALTERNATIVE,
+};
+
+/**
+ * the z such that a standard normal variable is below it with probability p
+ */
+float normalQuantile(float p) noexcept {
+  float low = -10.f;
+  float high = 10.f;
+  for (size_t iteration = 0; iteration < 64; ++iteration) {
+    float mid = (low + high) / 2.f;
+    if (0.5f * erfcf(-mid / sqrtf(2.f)) < p)
+      low = mid;
+    else
+      high = mid;
+  }
+  return (low + high) / 2.f;
+}
+}  // namespace
+
+SequentialResult compareSequentially(design::Fleet const &a,
+                                     design::Fleet const &b,
+                                     EvaluationSettings const &settings,
+                                     SequentialSettings const &sequential,
+                                     FirePool &pool,
+                                     ResultCache *cache) noexcept {
+  // replicate seeds are derived as if all maxFights fights were run
+  EvaluationSettings replicates = settings;
+  replicates.replicates = max(sequential.maxFights, size_t{2});
+
+  // Wald's thresholds on the log likelihood ratio
+  float upper = logf((1.f - sequential.beta) / sequential.alpha);
+  float lower = logf(sequential.beta / (1.f - sequential.alpha));
+  // log likelihood ratio per win, for "first wins with winProbability"
+  // against "first wins half the time"; a loss is a win for the other test
+  float winStep = logf(2.f * sequential.winProbability);
+  float lossStep = logf(2.f * (1.f - sequential.winProbability));
+
+  float firstRatio = 0.f;
+  float secondRatio = 0.f;
+  Decision firstDecision = Decision::CONTINUE;
+  Decision secondDecision = Decision::CONTINUE;
+
+  // running mean and variance of the difference in losses (Welford)
+  float differenceMean = 0.f;
+  float differenceSquares = 0.f;
+  float z = normalQuantile(1.f - sequential.alpha / 2.f);
+
+  SequentialResult result = {
+      .mean =
+          EvaluationResult{
+              .firstLoss = 0.f,
+              .secondLoss = 0.f,
+              .truncated = false,
+          },
+      .verdict = SequentialResult::Verdict::UNDECIDED,
+      .fights = 0,
+  };
+  while (result.fights < sequential.maxFights) {
+    EvaluationResult fight =
+        evaluate(a, b, replicate(replicates, result.fights), cache, pool);
+    ++result.fights;
+    result.mean.firstLoss += fight.firstLoss;
+    result.mean.secondLoss += fight.secondLoss;
+    result.mean.truncated = result.mean.truncated || fight.truncated;
+
+    float wins;
+    if (fight.firstLoss < fight.secondLoss)
+      wins = 1.f;
+    else if (fight.secondLoss < fight.firstLoss)
+      wins = 0.f;
+    else
+      wins = 0.5f;
+    firstRatio += wins * winStep + (1.f - wins) * lossStep;
+    secondRatio += wins * lossStep + (1.f - wins) * winStep;
+
+    float difference = fight.secondLoss - fight.firstLoss;
+    float delta = difference - differenceMean;
+    differenceMean += delta / static_cast<float>(result.fights);
+    differenceSquares += delta * (difference - differenceMean);
+
+    // don't stop part way through an antithetic pair
+    if (result.fights < sequential.minFights ||
+        (settings.antitheticPairs && result.fights % 2 == 1))
+      continue;
+
+    // each test stops for good once it crosses a threshold
+    if (firstDecision == Decision::CONTINUE) {
+      if (firstRatio >= upper)
+        firstDecision = Decision::ACCEPT_ALTERNATIVE;
+      else if (firstRatio <= lower)
+        firstDecision = Decision::ACCEPT_NULL;
+    }
+    if (secondDecision == Decision::CONTINUE) {
+      if (secondRatio >= upper)
+        secondDecision = Decision::ACCEPT_ALTERNATIVE;
+      else if (secondRatio <= lower)
+        secondDecision = Decision::ACCEPT_NULL;
+    }
+    if (firstDecision == Decision::ACCEPT_ALTERNATIVE) {
+      result.verdict = SequentialResult::Verdict::FIRST;
+      break;
+    } else if (secondDecision == Decision::ACCEPT_ALTERNATIVE) {
+      result.verdict = SequentialResult::Verdict::SECOND;
+      break;
+    } else if (firstDecision == Decision::ACCEPT_NULL &&
+               secondDecision == Decision::ACCEPT_NULL) {
+      result.verdict = SequentialResult::Verdict::DRAW;
+      break;
+    }
+
+    if (sequential.intervalWidth > 0.f && result.fights > 1) {
+      float halfWidth =
+          z * sqrtf(differenceSquares /
+                    static_cast<float>(result.fights - 1) /
+                    static_cast<float>(result.fights));
+      if (2.f * halfWidth <= sequential.intervalWidth) {
+        if (differenceMean - halfWidth > 0.f)
+          result.verdict = SequentialResult::Verdict::FIRST;
+        else if (differenceMean + halfWidth < 0.f)
+          result.verdict = SequentialResult::Verdict::SECOND;
+        else
+          result.verdict = SequentialResult::Verdict::DRAW;
+        break;
+      }
+    }
+  }
+
+  if (result.fights > 0) {
+    result.mean.firstLoss /= static_cast<float>(result.fights);
+    result.mean.secondLoss /= static_cast<float>(result.fights);
+  }
+  return result;
+}
+}  // namespace athena2::model
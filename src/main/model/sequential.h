@@ -0,0 +1,87 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ATHENA2_MODEL_SEQUENTIAL_H_
+#define ATHENA2_MODEL_SEQUENTIAL_H_
+
+#include <cstddef>
+
+#include "model/cache.h"
+#include "model/design/fleet.h"
+#include "model/evaluator.h"
+#include "model/firePool.h"
+
+namespace athena2::model {
+struct SequentialSettings {
+  /**
+   * chance of declaring a winner between evenly matched fleets
+   */
+  float alpha;
+  /**
+   * chance of missing a winner that wins at least winProbability of its
+   * fights
+   */
+  float beta;
+  /**
+   * smallest chance of winning a fight worth calling a win; ties count as
+   * half a win
+   */
+  float winProbability;
+  /**
+   * also stop once the confidence interval for the mean difference in losses
+   * is narrower than this many mineral-equivalents; zero to only stop on the
+   * sequential probability ratio test
+   */
+  float intervalWidth;
+  std::size_t minFights;
+  std::size_t maxFights;
+};
+struct SequentialResult {
+  enum class Verdict {
+    FIRST,
+    SECOND,
+    DRAW,
+    UNDECIDED,
+  };
+
+  /**
+   * mean losses over all fights run
+   */
+  EvaluationResult mean;
+  Verdict verdict;
+  std::size_t fights;
+};
+/**
+ * run replicate fights between two fleets until one is shown to be better,
+ * or they are shown to be evenly matched, or maxFights is reached
+ *
+ * uses a pair of Wald sequential probability ratio tests, one per possible
+ * winner, against a win probability of one half; settings.replicates is
+ * ignored, and fights are looked up in the cache if one is given. Every
+ * fight runs on the given pool
+ */
+SequentialResult compareSequentially(design::Fleet const &a,
+                                     design::Fleet const &b,
+                                     EvaluationSettings const &settings,
+                                     SequentialSettings const &sequential,
+                                     FirePool &pool,
+                                     ResultCache *cache = nullptr) noexcept;
+}  // namespace athena2::model
+
+#endif  // ATHENA2_MODEL_SEQUENTIAL_H_
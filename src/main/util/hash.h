@@ -0,0 +1,54 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ATHENA2_UTIL_HASH_H_
+#define ATHENA2_UTIL_HASH_H_
+
+#include <bit>
+#include <cstdint>
+#include <string_view>
+
+namespace athena2::util {
+/**
+ * 64 bit FNV-1a hash of some bytes
+ */
+inline std::uint64_t hashBytes(std::string_view bytes) noexcept {
+  std::uint64_t hash = 0xcbf29ce484222325;
+  for (char c : bytes) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 0x100000001b3;
+  }
+  return hash;
+}
+/**
+ * mix a value into a running hash; order matters
+ */
+inline std::uint64_t hashCombine(std::uint64_t hash,
+                                 std::uint64_t value) noexcept {
+  value += 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111eb;
+  return hash ^ value ^ (value >> 31);
+}
+inline std::uint64_t hashCombine(std::uint64_t hash, float value) noexcept {
+  return hashCombine(hash, std::uint64_t{std::bit_cast<std::uint32_t>(value)});
+}
+}  // namespace athena2::util
+
+#endif  // ATHENA2_UTIL_HASH_H_
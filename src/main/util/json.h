@@ -20,9 +20,12 @@
 #ifndef ATHENA2_UTIL_JSON_H_
 #define ATHENA2_UTIL_JSON_H_
 
+#include <cstdint>
+#include <initializer_list>
 #include <limits>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -40,52 +43,56 @@ inline nlohmann::json parse(std::istream &stream, EvalContext &ctx) {
 inline nlohmann::json const &checkType(nlohmann::json const &json,
                                        bool (nlohmann::json::*typechecker)()
                                            const,
-                                       std::string const &type,
+                                       std::string_view type,
                                        EvalContext &ctx) {
-  if (!(json.*typechecker)()) ctx.error("expected " + type);
+  if (!(json.*typechecker)()) ctx.error("expected " + std::string(type));
   return json;
 }
 inline nlohmann::json const &checkField(nlohmann::json const &json,
-                                        std::string const &key,
+                                        std::string_view key,
                                         EvalContext &ctx) {
-  if (!json.contains(key)) {
-    ctx.error("missing field " + key);
+  auto field = json.find(key);
+  if (field == json.end()) {
+    ctx.error("missing field " + std::string(key));
   }
 
-  return json[key];
+  return *field;
 }
 inline nlohmann::json const &checkFieldType(
-    nlohmann::json const &json, std::string const &key,
-    bool (nlohmann::json::*typechecker)() const, std::string const &type,
+    nlohmann::json const &json, std::string_view key,
+    bool (nlohmann::json::*typechecker)() const, std::string_view type,
     EvalContext &ctx) {
-  if (!json.contains(key)) {
-    ctx.error("missing field " + key);
-  } else if (!(json[key].*typechecker)()) {
+  auto field = json.find(key);
+  if (field == json.end()) {
+    ctx.error("missing field " + std::string(key));
+  } else if (!((*field).*typechecker)()) {
     auto _ = ctx.push(key);
-    ctx.error("expected field of type " + type);
+    ctx.error("expected field of type " + std::string(type));
   }
 
-  return json[key];
+  return *field;
 }
 inline nlohmann::json const *checkMaybeFieldType(
-    nlohmann::json const &json, std::string const &key,
-    bool (nlohmann::json::*typechecker)() const, std::string const &type,
+    nlohmann::json const &json, std::string_view key,
+    bool (nlohmann::json::*typechecker)() const, std::string_view type,
     EvalContext &ctx) {
-  if (!json.contains(key)) {
+  auto field = json.find(key);
+  if (field == json.end()) {
     return nullptr;
-  } else if (!(json[key].*typechecker)()) {
-    ctx.error("expected " + type + " for field " + key);
+  } else if (!((*field).*typechecker)()) {
+    ctx.error("expected " + std::string(type) + " for field " +
+              std::string(key));
   }
 
-  return &json[key];
+  return &*field;
 }
 inline std::string checkString(nlohmann::json const &json,
-                               std::string const &key, EvalContext &ctx) {
+                               std::string_view key, EvalContext &ctx) {
   return checkFieldType(json, key, &nlohmann::json::is_string, "string", ctx)
       .get<std::string>();
 }
 inline std::optional<std::string> checkMaybeString(nlohmann::json const &json,
-                                                   std::string const &key,
+                                                   std::string_view key,
                                                    EvalContext &ctx) {
   auto maybeField =
       checkMaybeFieldType(json, key, &nlohmann::json::is_string, "string", ctx);
@@ -94,13 +101,13 @@ inline std::optional<std::string> checkMaybeString(nlohmann::json const &json,
   else
     return maybeField->get<std::string>();
 }
-inline float checkFloat(nlohmann::json const &json, std::string const &key,
+inline float checkFloat(nlohmann::json const &json, std::string_view key,
                         EvalContext &ctx) {
   return checkFieldType(json, key, &nlohmann::json::is_number, "number", ctx)
       .get<float>();
 }
 inline size_t checkUnsignedInteger(nlohmann::json const &json,
-                                   std::string const &key, EvalContext &ctx) {
+                                   std::string_view key, EvalContext &ctx) {
   float value =
       checkFieldType(json, key, &nlohmann::json::is_number, "number", ctx)
           .get<float>();
@@ -116,8 +123,18 @@ inline size_t checkUnsignedInteger(nlohmann::json const &json,
   }
   return value;
 }
+inline std::optional<std::uint64_t> checkMaybeUnsignedInteger(
+    nlohmann::json const &json, std::string_view key, EvalContext &ctx) {
+  auto maybeField =
+      checkMaybeFieldType(json, key, &nlohmann::json::is_number_unsigned,
+                          "unsigned integer", ctx);
+  if (!maybeField)
+    return std::nullopt;
+  else
+    return maybeField->get<std::uint64_t>();
+}
 inline std::optional<float> checkMaybeFloat(nlohmann::json const &json,
-                                            std::string const &key,
+                                            std::string_view key,
                                             EvalContext &ctx) {
   auto maybeField =
       checkMaybeFieldType(json, key, &nlohmann::json::is_number, "number", ctx);
@@ -127,7 +144,7 @@ inline std::optional<float> checkMaybeFloat(nlohmann::json const &json,
     return maybeField->get<float>();
 }
 inline std::optional<bool> checkMaybeBool(nlohmann::json const &json,
-                                          std::string const &key,
+                                          std::string_view key,
                                           EvalContext &ctx) {
   auto maybeField = checkMaybeFieldType(json, key, &nlohmann::json::is_boolean,
                                         "boolean", ctx);
@@ -137,31 +154,51 @@ inline std::optional<bool> checkMaybeBool(nlohmann::json const &json,
     return maybeField->get<bool>();
 }
 inline nlohmann::json const &checkArray(nlohmann::json const &json,
-                                        std::string const &key,
+                                        std::string_view key,
                                         EvalContext &ctx) {
   return checkFieldType(json, key, &nlohmann::json::is_array, "array", ctx);
 }
+inline nlohmann::json const *checkMaybeArray(nlohmann::json const &json,
+                                             std::string_view key,
+                                             EvalContext &ctx) {
+  return checkMaybeFieldType(json, key, &nlohmann::json::is_array, "array",
+                             ctx);
+}
 inline std::vector<std::string> checkStringArray(nlohmann::json const &json,
-                                                 std::string const &key,
+                                                 std::string_view key,
                                                  EvalContext &ctx) {
-  nlohmann::json array =
+  nlohmann::json const &array =
       checkFieldType(json, key, &nlohmann::json::is_array, "array", ctx);
   auto _ = ctx.push(key);
   std::vector<std::string> result;
-  for (auto const &[key, val] : array.items()) {
-    auto _ = ctx.push(key);
+  for (auto const &[idx, val] : array.items()) {
+    auto element = ctx.push(idx);
     result.push_back(checkType(val, &nlohmann::json::is_string, "string", ctx)
                          .get<std::string>());
   }
   return result;
 }
+inline std::optional<std::vector<float>> checkMaybeFloatArray(
+    nlohmann::json const &json, std::string_view key, EvalContext &ctx) {
+  auto maybeField =
+      checkMaybeFieldType(json, key, &nlohmann::json::is_array, "array", ctx);
+  if (!maybeField) return std::nullopt;
+  auto _ = ctx.push(key);
+  std::vector<float> result;
+  for (auto const &[idx, val] : maybeField->items()) {
+    auto element = ctx.push(idx);
+    result.push_back(checkType(val, &nlohmann::json::is_number, "number", ctx)
+                         .get<float>());
+  }
+  return result;
+}
 inline nlohmann::json const &checkObject(nlohmann::json const &json,
-                                         std::string const &key,
+                                         std::string_view key,
                                          EvalContext &ctx) {
   return checkFieldType(json, key, &nlohmann::json::is_object, "object", ctx);
 }
 inline nlohmann::json const *checkMaybeObject(nlohmann::json const &json,
-                                              std::string const &key,
+                                              std::string_view key,
                                               EvalContext &ctx) {
   return checkMaybeFieldType(json, key, &nlohmann::json::is_object, "object",
                              ctx);
@@ -171,7 +208,7 @@ inline nlohmann::json const &checkObject(nlohmann::json const &json,
   return checkType(json, &nlohmann::json::is_object, "object", ctx);
 }
 inline void checkFields(nlohmann::json const &json,
-                        std::vector<std::string> const &allowedFields,
+                        std::initializer_list<std::string_view> allowedFields,
                         EvalContext &ctx) {
   for (auto const &[key, _] : json.items()) {
     if (std::find(allowedFields.begin(), allowedFields.end(), key) ==
@@ -0,0 +1,153 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/cache.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "catch2/catch_test_macros.hpp"
+#include "model/testFleets.h"
+
+using namespace athena2;
+using namespace athena2::model;
+using namespace athena2::model::component;
+using namespace athena2::model::design;
+using namespace athena2::model::test;
+using namespace std;
+
+namespace {
+bool sameResult(EvaluationResult const &lhs,
+                EvaluationResult const &rhs) noexcept {
+  return lhs.firstLoss == rhs.firstLoss && lhs.secondLoss == rhs.secondLoss &&
+         lhs.truncated == rhs.truncated;
+}
+}  // namespace
+
+TEST_CASE("Result cache", "[model][cache]") {
+  EvalContext ctx("root");
+  ComponentSet components = testComponents(ctx);
+  Fleet guns = testFleet("Guns", "Interceptor",
+                         {"Small Red Laser", "Small Mass Driver",
+                          "Small Mass Driver"},
+                         3, components, ctx);
+  Fleet missiles = testFleet("Missiles", "Interceptor",
+                             {"Nuclear Missiles", "Nuclear Missiles",
+                              "Nuclear Missiles"},
+                             3, components, ctx);
+  EvaluationSettings settings = testSettings(42);
+  EvaluationSettings reseeded = settings;
+  reseeded.seed = 43;
+  string filename =
+      (filesystem::temp_directory_path() / "athena2-cache-test.bin").string();
+  remove(filename.c_str());
+
+  EvaluationResult first = evaluate(guns, missiles, settings);
+  EvaluationResult second = evaluate(guns, missiles, reseeded);
+  {
+    ResultCache cache = ResultCache::open(filename, components, ctx);
+    REQUIRE(sameResult(cache.evaluate(guns, missiles, settings), first));
+    REQUIRE(sameResult(cache.evaluate(guns, missiles, reseeded), second));
+    REQUIRE(sameResult(cache.evaluate(guns, missiles, settings), first));
+    REQUIRE(cache.hits == 1);
+    REQUIRE(cache.misses == 2);
+    REQUIRE(cache.writeFailures == 0);
+  }
+
+  SECTION("records round trip") {
+    ResultCache cache = ResultCache::open(filename, components, ctx);
+    REQUIRE(sameResult(cache.evaluate(guns, missiles, settings), first));
+    REQUIRE(sameResult(cache.evaluate(guns, missiles, reseeded), second));
+    REQUIRE(cache.hits == 2);
+    REQUIRE(cache.misses == 0);
+  }
+
+  SECTION("a partial record is cut off") {
+    uintmax_t whole = filesystem::file_size(filename);
+    {
+      ofstream torn(filename, ios::binary | ios::app);
+      torn.write("torn", 4);
+    }
+    EvaluationSettings later = settings;
+    later.seed = 44;
+    EvaluationResult third = evaluate(guns, missiles, later);
+    {
+      ResultCache cache = ResultCache::open(filename, components, ctx);
+      REQUIRE(filesystem::file_size(filename) == whole);
+      REQUIRE(sameResult(cache.evaluate(guns, missiles, later), third));
+      REQUIRE(cache.misses == 1);
+    }
+
+    // the record written after the cut is read back intact
+    ResultCache cache = ResultCache::open(filename, components, ctx);
+    REQUIRE(sameResult(cache.evaluate(guns, missiles, settings), first));
+    REQUIRE(sameResult(cache.evaluate(guns, missiles, reseeded), second));
+    REQUIRE(sameResult(cache.evaluate(guns, missiles, later), third));
+    REQUIRE(cache.hits == 3);
+    REQUIRE(cache.misses == 0);
+  }
+
+  SECTION("keys differ by settings, seed, version, and fleets") {
+    ResultCache cache = ResultCache::open(filename, components, ctx);
+    uint64_t key = cache.key(guns, missiles, settings);
+    REQUIRE(key != cache.key(guns, missiles, reseeded));
+    REQUIRE(key != cache.key(missiles, guns, settings));
+
+    EvaluationSettings longer = settings;
+    longer.fightLengthLimit = 240.f;
+    REQUIRE(key != cache.key(guns, missiles, longer));
+    EvaluationSettings withdrawing = settings;
+    withdrawing.withdrawMultiplier = 0.5f;
+    REQUIRE(key != cache.key(guns, missiles, withdrawing));
+    EvaluationSettings replicated = settings;
+    replicated.replicates = 2;
+    REQUIRE(key != cache.key(guns, missiles, replicated));
+
+    // settings that don't change the result share a key
+    EvaluationSettings threaded = settings;
+    threaded.fireThreads = 4;
+    threaded.adaptiveTimeStep = true;
+    REQUIRE(key == cache.key(guns, missiles, threaded));
+
+    // renaming doesn't change the key, but adding ships does
+    Fleet renamed = testFleet("Renamed", "Interceptor",
+                              {"Small Red Laser", "Small Mass Driver",
+                               "Small Mass Driver"},
+                              3, components, ctx);
+    REQUIRE(key == cache.key(renamed, missiles, settings));
+    Fleet bigger = testFleet("Guns", "Interceptor",
+                             {"Small Red Laser", "Small Mass Driver",
+                              "Small Mass Driver"},
+                             4, components, ctx);
+    REQUIRE(key != cache.key(bigger, missiles, settings));
+
+    uint64_t current = settingsHash(settings);
+    REQUIRE(current != settingsHash(settings, ATHENA2_VERSION_MAJOR + 1));
+    REQUIRE(current != settingsHash(settings, ATHENA2_VERSION_MAJOR,
+                                    ATHENA2_VERSION_MINOR + 1));
+    REQUIRE(current != settingsHash(settings, ATHENA2_VERSION_MAJOR,
+                                    ATHENA2_VERSION_MINOR,
+                                    ATHENA2_VERSION_PATCH + 1));
+  }
+
+  remove(filename.c_str());
+}
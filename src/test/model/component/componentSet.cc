@@ -0,0 +1,161 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/component/componentSet.h"
+
+#include <string>
+#include <utility>
+
+#include "catch2/catch_test_macros.hpp"
+#include "model/testFleets.h"
+#include "util/hash.h"
+
+using namespace athena2;
+using namespace athena2::model::component;
+using namespace athena2::model::test;
+using namespace std;
+
+namespace {
+ComponentSet::Loader<Utility> armour(string const &name, size_t &loads,
+                                     EvalContext &ctx) {
+  return [&name, &loads, &ctx]() {
+    ++loads;
+    nlohmann::json data = R"({
+  "size": "S",
+  "power": 0,
+  "armourHealth": 100,
+  "cost": {}
+})"_json;
+    data["name"] = name;
+    return pair<Utility, uint64_t>(Utility::fromJson(data, ctx),
+                                   util::hashBytes(data.dump()));
+  };
+}
+nlohmann::json laser(string const &name, float cooldown) {
+  nlohmann::json data = testLaserJson(name, 0.f, 16.f);
+  data["cooldown"] = cooldown;
+  return data;
+}
+}  // namespace
+
+TEST_CASE("Deferred components load on first use",
+          "[model][component][componentSet]") {
+  EvalContext ctx("root");
+  ComponentSet components;
+  size_t loads = 0;
+  string first = "First";
+  string second = "Second";
+  components.defer(first, armour(first, loads, ctx), ctx, 1);
+  components.defer(second, armour(second, loads, ctx), ctx, 0);
+  REQUIRE(loads == 0);
+  REQUIRE(components.getUtility(ComponentId{0}) == nullptr);
+
+  Utility const *second1 = components.getUtility("Second");
+  REQUIRE(loads == 1);
+  REQUIRE(second1->name == "Second");
+  REQUIRE(components.getUtility("Second") == second1);
+  REQUIRE(loads == 1);
+  REQUIRE(components.getUtility("Third") == nullptr);
+
+  components.loadAll();
+  REQUIRE(loads == 2);
+  REQUIRE(components.getUtility("Second") == second1);
+  REQUIRE(components.idOf(*second1) == 1);
+  REQUIRE(components.idOf(*components.getUtility("First")) == 0);
+  REQUIRE(components.getUtility(ComponentId{1}) == second1);
+  REQUIRE(components.utilityView({.maxTier = 0}).get("First") == nullptr);
+
+  REQUIRE_THROWS_WITH(
+      components.defer(first, armour(first, loads, ctx), ctx),
+      "Error: root: duplicate component First");
+}
+
+TEST_CASE("Ids follow the load list however lazily it loads",
+          "[model][component][componentSet]") {
+  EvalContext ctx("root");
+  size_t loads = 0;
+  string first = "First";
+  string second = "Second";
+  string third = "Third";
+  ComponentSet forwards;
+  ComponentSet backwards;
+  for (ComponentSet *components : {&forwards, &backwards}) {
+    components->defer(first, armour(first, loads, ctx), ctx);
+    components->defer(second, armour(second, loads, ctx), ctx);
+    components->defer(third, armour(third, loads, ctx), ctx);
+  }
+
+  forwards.getUtility("First");
+  forwards.getUtility("Third");
+  backwards.getUtility("Third");
+  backwards.getUtility("First");
+  REQUIRE(forwards.idOf(*forwards.getUtility("Third")) == 2);
+  REQUIRE(backwards.idOf(*backwards.getUtility("Third")) == 2);
+  REQUIRE(backwards.getUtility(ComponentId{1}) == nullptr);
+
+  forwards.loadAll();
+  backwards.loadAll();
+  REQUIRE(forwards.fingerprint() == backwards.fingerprint());
+}
+
+TEST_CASE("Deferred components report errors when loaded",
+          "[model][component][componentSet]") {
+  EvalContext ctx("root");
+  ComponentSet components;
+  components.defer(
+      "Broken",
+      ComponentSet::Loader<Utility>([&ctx]() -> pair<Utility, uint64_t> {
+        auto _ = ctx.push("broken.json");
+        ctx.error("missing field size");
+      }),
+      ctx);
+  REQUIRE_THROWS_WITH(components.getUtility("Broken"),
+                      "Error: root > broken.json: missing field size");
+}
+
+TEST_CASE("Weapon stats are stored densely by id",
+          "[model][component][componentSet]") {
+  EvalContext ctx("root");
+  ComponentSet components;
+  addComponent<Weapon>(components, laser("First", 1.f), ctx);
+  addComponent<Weapon>(components, laser("Second", 2.f), ctx);
+  components.defer(
+      "Third",
+      ComponentSet::Loader<Weapon>([&ctx]() {
+        nlohmann::json data = laser("Third", 3.f);
+        return pair<Weapon, uint64_t>(Weapon::fromJson(data, ctx),
+                                      util::hashBytes(data.dump()));
+      }),
+      ctx);
+  Weapon::Stats const *first = components.getWeaponStats(ComponentId{0});
+  REQUIRE(components.getWeaponStats(ComponentId{1}) != nullptr);
+  REQUIRE(components.getWeaponStats(ComponentId{2}) == nullptr);
+
+  // stats already handed out stay put when a deferred weapon loads
+  components.loadAll();
+  REQUIRE(components.getWeaponStats(ComponentId{0}) == first);
+  for (ComponentId id = 0; id < 3; ++id) {
+    Weapon const *weapon = components.getWeapon(id);
+    REQUIRE(weapon->stats == components.getWeaponStats(id));
+    REQUIRE(weapon->stats == components.getWeaponStats(0) + id);
+  }
+  REQUIRE(components.getWeapon("First")->stats->cooldown == 1.f);
+  REQUIRE(components.getWeapon("Second")->stats->cooldown == 2.f);
+  REQUIRE(components.getWeapon("Third")->stats->cooldown == 3.f);
+}
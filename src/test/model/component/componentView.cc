@@ -0,0 +1,77 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/component/componentView.h"
+
+#include <string>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "model/component/componentSet.h"
+#include "model/testFleets.h"
+
+using namespace athena2;
+using namespace athena2::model::component;
+using namespace athena2::model::test;
+using namespace std;
+
+namespace {
+nlohmann::json armour(string const &name, string const &size) {
+  nlohmann::json data = R"({
+  "power": 0,
+  "armourHealth": 100,
+  "cost": {}
+})"_json;
+  data["name"] = name;
+  data["size"] = size;
+  return data;
+}
+
+vector<string> names(ComponentView<Utility> const &view) {
+  vector<string> result;
+  for (Utility const &utility : view) result.push_back(utility.name);
+  return result;
+}
+}  // namespace
+
+TEST_CASE("Component views filter by tier and size",
+          "[model][component][componentView]") {
+  EvalContext ctx("root");
+  ComponentSet components;
+  addComponent<Utility>(components, armour("Large 2", "L"), ctx, 2);
+  addComponent<Utility>(components, armour("Small 0", "S"), ctx, 0);
+  addComponent<Utility>(components, armour("Small 3", "S"), ctx, 3);
+  addComponent<Utility>(components, armour("Large 0", "L"), ctx, 0);
+
+  REQUIRE(names(components.utilityView()) ==
+          vector<string>{"Small 0", "Large 0", "Large 2", "Small 3"});
+  REQUIRE(names(components.utilityView({.maxTier = 2})) ==
+          vector<string>{"Small 0", "Large 0", "Large 2"});
+  REQUIRE(names(components.utilityView({.minTier = 1, .maxTier = 2})) ==
+          vector<string>{"Large 2"});
+  REQUIRE(names(components.utilityView({.size = "S"})) ==
+          vector<string>{"Small 0", "Small 3"});
+  REQUIRE(names(components.utilityView({.minTier = 4})).empty());
+
+  ComponentView<Utility> early = components.utilityView({.maxTier = 2});
+  REQUIRE(early.get("Large 2") == components.getUtility("Large 2"));
+  REQUIRE(early.get("Small 3") == nullptr);
+  REQUIRE(early.matches(*components.getUtility("Small 0")));
+  REQUIRE_FALSE(early.matches(*components.getUtility("Small 3")));
+}
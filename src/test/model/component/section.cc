@@ -19,6 +19,8 @@
 
 #include "model/component/section.h"
 
+#include <string>
+
 #include "catch2/catch_test_macros.hpp"
 
 using namespace athena2;
@@ -59,3 +61,23 @@ TEST_CASE("Section parsing with all fields", "[model][component][section]") {
   REQUIRE(interceptor.utilitySlots == "ASSS");
   REQUIRE(interceptor.cost == 60.f);
 }
+
+TEST_CASE("Section slots must be capital letters that fit a slot set",
+          "[model][component][section]") {
+  EvalContext ctx("root");
+  nlohmann::json data = R"({
+  "name": "Interceptor",
+  "size": "KC",
+  "weaponSlots": "SSS",
+  "utilitySlots": "SSSA"
+})"_json;
+  data["weaponSlots"] = "Ss";
+  REQUIRE_THROWS(Section::fromJson(data, ctx));
+  data["weaponSlots"] = "SSS";
+  data["utilitySlots"] = "S3";
+  REQUIRE_THROWS(Section::fromJson(data, ctx));
+  data["utilitySlots"] = string(SlotSet::MAX_COUNT, 'S');
+  REQUIRE_NOTHROW(Section::fromJson(data, ctx));
+  data["utilitySlots"] = string(SlotSet::MAX_COUNT + 1, 'S');
+  REQUIRE_THROWS(Section::fromJson(data, ctx));
+}
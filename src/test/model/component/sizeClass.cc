@@ -0,0 +1,72 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/component/sizeClass.h"
+
+#include <string>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "model/component/hull.h"
+#include "model/component/reactor.h"
+
+using namespace athena2;
+using namespace athena2::model::component;
+using namespace std;
+
+TEST_CASE("A size name numbers the same wherever it's named",
+          "[model][component][sizeClass]") {
+  EvalContext ctx("root");
+  REQUIRE(sectionSizeLane("Test Bow", ctx) == sectionSizeLane("Test Bow", ctx));
+  REQUIRE(sectionSizeLane("Test Bow", ctx) !=
+          sectionSizeLane("Test Stern", ctx));
+  REQUIRE(coreSizeBit("Test Core", ctx) == coreSizeBit("Test Core", ctx));
+  REQUIRE((coreSizeBit("Test Core", ctx) & coreSizeBit("Other Core", ctx)) ==
+          0);
+  REQUIRE(coreSizeMask({"Test Core", "Other Core"}, ctx) ==
+          (coreSizeBit("Test Core", ctx) | coreSizeBit("Other Core", ctx)));
+
+  Hull hull = Hull::fromJson(R"({
+  "name": "Test Hull",
+  "size": 1,
+  "coreSize": "Test Core",
+  "sectionSizes": ["Test Bow", "Test Bow"],
+  "hullHealth": 200,
+  "evasion": 0.6,
+  "speed": 160,
+  "disengageChanceModifier": 0
+}
+)"_json,
+                             ctx);
+  Reactor reactor = Reactor::fromJson(R"({
+  "name": "Test Reactor",
+  "sizes": ["Other Core", "Test Core"],
+  "power": 10,
+  "cost": {}
+}
+)"_json,
+                                      ctx);
+  REQUIRE((reactor.sizeMask & hull.coreSizeBit) != 0);
+  SlotSet bows;
+  bows.addLane(sectionSizeLane("Test Bow", ctx));
+  bows.addLane(sectionSizeLane("Test Bow", ctx));
+  REQUIRE(bows.fitsIn(hull.sectionSlotSet));
+  bows.addLane(sectionSizeLane("Test Bow", ctx));
+  REQUIRE_FALSE(bows.fitsIn(hull.sectionSlotSet));
+}
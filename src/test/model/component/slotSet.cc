@@ -0,0 +1,37 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/component/slotSet.h"
+
+#include "catch2/catch_test_macros.hpp"
+
+using namespace athena2::model::component;
+using namespace std;
+
+TEST_CASE("Slot sets fit only with enough slots of each size",
+          "[model][component][slotSet]") {
+  REQUIRE(SlotSet("").fitsIn(SlotSet("")));
+  REQUIRE(SlotSet("SM").fitsIn(SlotSet("LMMS")));
+  REQUIRE(SlotSet("MM").fitsIn(SlotSet("LMMS")));
+  REQUIRE_FALSE(SlotSet("MMM").fitsIn(SlotSet("LMMS")));
+  REQUIRE_FALSE(SlotSet("G").fitsIn(SlotSet("LMMS")));
+  REQUIRE_FALSE(SlotSet("LMMSS").fitsIn(SlotSet("LMMS")));
+  REQUIRE(SlotSet(string(127, 'S')).fitsIn(SlotSet(string(127, 'S'))));
+  REQUIRE_FALSE(SlotSet(string(127, 'S')).fitsIn(SlotSet(string(126, 'S'))));
+}
@@ -43,3 +43,20 @@ TEST_CASE("Utility parsing", "[model][component][utility]") {
   REQUIRE(utility.shieldRegen == 0.5f);
   REQUIRE(utility.cost == 10.f);
 }
+
+TEST_CASE("Utility sizes must be capital letters",
+          "[model][component][utility]") {
+  EvalContext ctx("root");
+  nlohmann::json data = R"({
+  "name": "Small Deflectors",
+  "size": "S",
+  "power": -15,
+  "cost": {}
+})"_json;
+  REQUIRE_NOTHROW(Utility::fromJson(data, ctx));
+  // lowercase letters and digits would share lanes with capitals
+  for (char const *size : {"s", "3", "SS"}) {
+    data["size"] = size;
+    REQUIRE_THROWS(Utility::fromJson(data, ctx));
+  }
+}
@@ -48,20 +48,54 @@ TEST_CASE("Weapon parsing", "[model][component][weapon]") {
 })"_json,
                                    ctx);
   REQUIRE(weapon.name == "Small Red Laser");
+  REQUIRE(weapon.stats->type == Weapon::Type::REGULAR);
   REQUIRE(weapon.size == "S");
   REQUIRE(weapon.tag == "energy");
   REQUIRE(weapon.power == -5.f);
-  REQUIRE(weapon.minDamage == 6.f);
-  REQUIRE(weapon.maxDamage == 16);
-  REQUIRE(weapon.cooldown == 4.25f);
-  REQUIRE(weapon.accuracy == 0.9f);
-  REQUIRE(weapon.tracking == 0.5f);
-  REQUIRE(weapon.minRange == 0.f);
-  REQUIRE(weapon.maxRange == 40.f);
-  REQUIRE(weapon.shieldDamageModifier == -0.5f);
-  REQUIRE(weapon.shieldSkipModifier == 0.f);
-  REQUIRE(weapon.armourDamageModifier == 0.5f);
-  REQUIRE(weapon.armourSkipModifier == 0.f);
-  REQUIRE(weapon.hullDamageModifier == 0.25f);
+  REQUIRE(weapon.stats->minDamage == 6.f);
+  REQUIRE(weapon.stats->maxDamage == 16);
+  REQUIRE(weapon.stats->cooldown == 4.25f);
+  REQUIRE(weapon.stats->accuracy == 0.9f);
+  REQUIRE(weapon.stats->tracking == 0.5f);
+  REQUIRE(weapon.stats->minRange == 0.f);
+  REQUIRE(weapon.stats->maxRange == 40.f);
+  REQUIRE(weapon.stats->shieldDamageModifier == -0.5f);
+  REQUIRE(weapon.stats->shieldSkipModifier == 0.f);
+  REQUIRE(weapon.stats->armourDamageModifier == 0.5f);
+  REQUIRE(weapon.stats->armourSkipModifier == 0.f);
+  REQUIRE(weapon.stats->hullDamageModifier == 0.25f);
+  REQUIRE_FALSE(weapon.stats->explosive);
+  REQUIRE_FALSE(weapon.stats->pointDefence);
   REQUIRE(weapon.cost == 20.f);
 }
+
+TEST_CASE("Weapon tags", "[model][component][weapon]") {
+  EvalContext ctx("root");
+  auto withTag = [&ctx](string const &tag) {
+    nlohmann::json data = R"({
+  "name": "Sentinel Point-Defence",
+  "size": "P",
+  "power": -5,
+  "minDamage": 3,
+  "maxDamage": 7,
+  "cooldown": 0.33,
+  "accuracy": 1,
+  "tracking": 0.6,
+  "minRange": 0,
+  "maxRange": 30,
+  "cost": {
+    "alloys": 5
+  }
+})"_json;
+    data["tag"] = tag;
+    return Weapon::fromJson(data, ctx);
+  };
+
+  Weapon pointDefence = withTag("point-defence");
+  REQUIRE(pointDefence.stats->pointDefence);
+  REQUIRE_FALSE(pointDefence.stats->explosive);
+
+  Weapon explosive = withTag("explosive");
+  REQUIRE(explosive.stats->explosive);
+  REQUIRE_FALSE(explosive.stats->pointDefence);
+}
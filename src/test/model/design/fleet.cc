@@ -0,0 +1,82 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/design/fleet.h"
+
+#include <string>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "model/testFleets.h"
+
+using namespace athena2;
+using namespace athena2::model::component;
+using namespace athena2::model::design;
+using namespace athena2::model::test;
+using namespace std;
+using namespace nlohmann;
+
+namespace {
+json entryJson(string const &name, vector<string> const &weapons,
+               size_t count) {
+  return json{{"ship", testShipJson(name, "Interceptor", weapons)},
+              {"count", count}};
+}
+}  // namespace
+
+TEST_CASE("Fleet canonical form", "[model][design][fleet]") {
+  EvalContext ctx("root");
+  ComponentSet components = testComponents(ctx);
+  vector<string> guns = {"Small Red Laser", "Small Mass Driver",
+                         "Small Mass Driver"};
+  vector<string> permutedGuns = {"Small Mass Driver", "Small Red Laser",
+                                 "Small Mass Driver"};
+  vector<string> missiles = {"Nuclear Missiles", "Nuclear Missiles",
+                             "Nuclear Missiles"};
+  Fleet fleet = Fleet::fromJson(
+      json{{"name", "Mixed"},
+           {"ships", {entryJson("Alpha", guns, 2),
+                      entryJson("Beta", missiles, 1),
+                      entryJson("Gamma", permutedGuns, 3)}}},
+      components, ctx);
+  Fleet reordered = Fleet::fromJson(
+      json{{"name", "Reordered"},
+           {"ships", {entryJson("Delta", missiles, 1),
+                      entryJson("Epsilon", permutedGuns, 5)}}},
+      components, ctx);
+
+  REQUIRE_FALSE(fleet.sameDesign(reordered));
+  Fleet canonical = fleet.canonical();
+  REQUIRE(canonical.sameDesign(reordered.canonical()));
+  REQUIRE(canonical.name == fleet.name);
+
+  // permuted designs merge into one entry with their counts summed
+  REQUIRE(canonical.ships.size() == 2);
+  size_t total = 0;
+  for (auto const &[ship, count] : canonical.ships) total += count;
+  REQUIRE(total == 6);
+  REQUIRE(canonical.sameDesign(canonical.canonical()));
+
+  Fleet fewer = Fleet::fromJson(
+      json{{"name", "Fewer"},
+           {"ships", {entryJson("Delta", missiles, 1),
+                      entryJson("Epsilon", permutedGuns, 4)}}},
+      components, ctx);
+  REQUIRE_FALSE(canonical.sameDesign(fewer.canonical()));
+}
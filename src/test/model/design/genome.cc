@@ -0,0 +1,140 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/design/genome.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <utility>
+
+#include "catch2/catch_test_macros.hpp"
+#include "model/testFleets.h"
+
+using namespace athena2;
+using namespace athena2::model::component;
+using namespace athena2::model::design;
+using namespace athena2::model::test;
+using namespace std;
+
+namespace {
+/**
+ * the shared test components, with an auxiliary to fill the auxiliary slot
+ */
+ComponentSet boostedComponents(EvalContext &ctx) {
+  ComponentSet components = testComponents(ctx);
+  addComponent<Auxiliary>(components, R"({
+  "name": "Reactor Booster",
+  "power": 20,
+  "cost": {}
+})"_json,
+                          ctx);
+  return components;
+}
+
+Ship testShip(ComponentSet const &components, EvalContext &ctx) {
+  return Ship::fromJson(
+      testShipJson("Test", "Interceptor",
+                   {"Small Red Laser", "Small Red Laser"},
+                   {"Small Deflectors"}, {"Reactor Booster"}),
+      components, ctx);
+}
+ComponentSet::Loader<Utility> spare(EvalContext &ctx) {
+  return [&ctx]() {
+    return pair<Utility, uint64_t>(Utility::fromJson(R"({
+  "name": "Spare Plating",
+  "size": "S",
+  "power": 0,
+  "armourHealth": 100,
+  "cost": {}
+})"_json,
+                                                     ctx),
+                                   1);
+  };
+}
+}  // namespace
+
+TEST_CASE("Genomes round trip through designs", "[model][design][genome]") {
+  EvalContext ctx("root");
+  ComponentSet components = boostedComponents(ctx);
+  Ship ship = testShip(components, ctx);
+
+  optional<Genome> genome = Genome::encode(ship, components);
+  REQUIRE(genome.has_value());
+  REQUIRE(genome->words[6] == Genome::NONE);
+  optional<Ship> decoded = genome->decode("Test", components);
+  REQUIRE(decoded.has_value());
+  REQUIRE(decoded->sameDesign(ship));
+  REQUIRE(decoded->name == ship.name);
+  REQUIRE(Genome::encode(*decoded, components) == genome);
+  REQUIRE(Genome::encode(*decoded, components)->hash() == genome->hash());
+}
+
+TEST_CASE("Invalid genomes don't decode", "[model][design][genome]") {
+  EvalContext ctx("root");
+  ComponentSet components = boostedComponents(ctx);
+  Genome genome = *Genome::encode(testShip(components, ctx), components);
+
+  Genome missingComponent = genome;
+  missingComponent.words[Genome::CORE_WORDS + 1] = 0x7ffe;
+  REQUIRE_FALSE(missingComponent.decode("Test", components).has_value());
+
+  Genome tooManyWeapons = genome;
+  for (size_t idx = 1; idx <= 4; ++idx)
+    tooManyWeapons.words[Genome::CORE_WORDS + idx] = 0;
+  REQUIRE_FALSE(tooManyWeapons.decode("Test", components).has_value());
+
+  REQUIRE_FALSE(Genome().decode("Test", components).has_value());
+}
+
+TEST_CASE("Genome files round trip", "[model][design][genome]") {
+  EvalContext ctx("root");
+  ComponentSet components = boostedComponents(ctx);
+  Genome genome = *Genome::encode(testShip(components, ctx), components);
+  string filename =
+      (filesystem::temp_directory_path() / "athena2-genome-test.bin").string();
+
+  writeGenomes(filename, {genome, Genome(), genome}, components, ctx);
+  vector<Genome> read = readGenomes(filename, components, ctx);
+  remove(filename.c_str());
+  REQUIRE(read.size() == 3);
+  REQUIRE(read[0] == genome);
+  REQUIRE(read[1] == Genome());
+  REQUIRE(read[2] == genome);
+}
+
+TEST_CASE("Genome files cover deferred components",
+          "[model][design][genome]") {
+  EvalContext ctx("root");
+  auto withSpare = [&ctx]() {
+    ComponentSet components = boostedComponents(ctx);
+    components.defer("Spare Plating", spare(ctx), ctx);
+    return components;
+  };
+  ComponentSet components = withSpare();
+  Genome genome = *Genome::encode(testShip(components, ctx), components);
+  string filename =
+      (filesystem::temp_directory_path() / "athena2-genome-test.bin").string();
+
+  uint64_t partial = components.fingerprint();
+  writeGenomes(filename, {genome}, components, ctx);
+  REQUIRE(components.fingerprint() != partial);
+  vector<Genome> read = readGenomes(filename, withSpare(), ctx);
+  remove(filename.c_str());
+  REQUIRE(read == vector<Genome>{genome});
+}
@@ -0,0 +1,115 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/design/section.h"
+
+#include <string>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "model/testFleets.h"
+
+using namespace athena2;
+using namespace athena2::model::component;
+using namespace athena2::model::design;
+using namespace athena2::model::test;
+using namespace std;
+using namespace nlohmann;
+
+namespace {
+json sectionJson(vector<string> const &weapons,
+                 vector<string> const &utilities) {
+  return json{{"section", "Interceptor"},
+              {"weapons", weapons},
+              {"utilities", utilities},
+              {"auxiliaries", json::array()}};
+}
+}  // namespace
+
+TEST_CASE("Section canonical form", "[model][design][section]") {
+  EvalContext ctx("root");
+  ComponentSet components = testComponents(ctx);
+  model::design::Section section = model::design::Section::fromJson(
+      sectionJson(
+          {"Small Red Laser", "Small Mass Driver", "Small Mass Driver"},
+          {"Small Deflectors"}),
+      components, ctx);
+  model::design::Section permuted = model::design::Section::fromJson(
+      sectionJson(
+          {"Small Mass Driver", "Small Red Laser", "Small Mass Driver"},
+          {"Small Deflectors"}),
+      components, ctx);
+  model::design::Section other = model::design::Section::fromJson(
+      sectionJson(
+          {"Small Mass Driver", "Small Mass Driver", "Small Mass Driver"},
+          {"Small Deflectors"}),
+      components, ctx);
+
+  REQUIRE_FALSE(section.sameDesign(permuted));
+  REQUIRE(section.canonical().sameDesign(permuted.canonical()));
+  REQUIRE_FALSE(section.canonical().sameDesign(other.canonical()));
+
+  // contents are sorted by name, and the normal form is its own normal form
+  model::design::Section canonical = section.canonical();
+  REQUIRE(canonical.weapons.size() == 3);
+  REQUIRE(canonical.weapons[0]->name == "Small Mass Driver");
+  REQUIRE(canonical.weapons[1]->name == "Small Mass Driver");
+  REQUIRE(canonical.weapons[2]->name == "Small Red Laser");
+  REQUIRE(canonical.sameDesign(canonical.canonical()));
+}
+
+TEST_CASE("Section validation", "[model][design][section]") {
+  EvalContext ctx("root");
+  ComponentSet components = testComponents(ctx);
+  model::component::Section const &interceptor =
+      *components.getSection("Interceptor");
+  model::component::Section const &carrier = *components.getSection("Carrier");
+  Weapon const *laser = components.getWeapon("Small Red Laser");
+  Weapon const *pointDefence = components.getWeapon("Sentinel Point-Defence");
+  Utility const *deflectors = components.getUtility("Small Deflectors");
+
+  REQUIRE(model::design::Section::validate(interceptor, {laser, laser, laser},
+                                           {deflectors}, {}) ==
+          DesignError::NONE);
+  REQUIRE(model::design::Section::validate(carrier, {pointDefence}, {}, {}) ==
+          DesignError::NONE);
+  REQUIRE(model::design::Section::validate(interceptor, {}, {}, {}) ==
+          DesignError::NONE);
+
+  // too many weapons, or one needing a slot the section doesn't have
+  REQUIRE(model::design::Section::validate(
+              interceptor, {laser, laser, laser, laser}, {}, {}) ==
+          DesignError::WEAPON_SLOTS);
+  REQUIRE(model::design::Section::validate(interceptor, {pointDefence}, {},
+                                           {}) == DesignError::WEAPON_SLOTS);
+
+  // the carrier has two small utility slots
+  REQUIRE(model::design::Section::validate(
+              carrier, {}, {deflectors, deflectors, deflectors}, {}) ==
+          DesignError::UTILITY_SLOTS);
+
+  REQUIRE_THROWS_WITH(
+      model::design::Section::fromJson(
+          sectionJson({"Small Red Laser", "Small Red Laser", "Small Red Laser",
+                       "Small Red Laser"},
+                      {}),
+          components, ctx),
+      "Error: root: invalid section design: weapons requiring missing slots "
+      "(S) found in section design");
+}
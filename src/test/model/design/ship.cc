@@ -0,0 +1,244 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/design/ship.h"
+
+#include <string>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "model/testFleets.h"
+
+using namespace athena2;
+using namespace athena2::model::component;
+using namespace athena2::model::design;
+using namespace athena2::model::test;
+using namespace std;
+using namespace nlohmann;
+
+TEST_CASE("Ship canonical form", "[model][design][ship]") {
+  EvalContext ctx("root");
+  ComponentSet components = testComponents(ctx);
+  Ship ship = Ship::fromJson(
+      testShipJson(
+          "Alpha", "Interceptor",
+          {"Small Red Laser", "Small Mass Driver", "Small Mass Driver"}),
+      components, ctx);
+  Ship permuted = Ship::fromJson(
+      testShipJson(
+          "Beta", "Interceptor",
+          {"Small Mass Driver", "Small Mass Driver", "Small Red Laser"}),
+      components, ctx);
+  Ship other = Ship::fromJson(
+      testShipJson(
+          "Alpha", "Interceptor",
+          {"Nuclear Missiles", "Small Mass Driver", "Small Red Laser"}),
+      components, ctx);
+
+  REQUIRE(ship.name == "Alpha-class Corvette");
+  REQUIRE_FALSE(ship.sameDesign(permuted));
+  REQUIRE(ship.canonical().sameDesign(permuted.canonical()));
+  REQUIRE_FALSE(ship.canonical().sameDesign(other.canonical()));
+
+  // names don't change, however they're spelled
+  REQUIRE(ship.canonical().name == ship.name);
+  Ship awkward = Ship::fromJson(
+      testShipJson(
+          "Corvette-class Corvette", "Interceptor",
+          {"Small Red Laser", "Small Mass Driver", "Small Mass Driver"}),
+      components, ctx);
+  REQUIRE(awkward.canonical().name == awkward.name);
+  REQUIRE(awkward.canonical().sameDesign(permuted.canonical()));
+}
+
+TEST_CASE("Ship canonical form sorts sections", "[model][design][ship]") {
+  EvalContext ctx("root");
+  ComponentSet components = testComponents(ctx);
+  addComponent<Hull>(components, R"({
+  "name": "Destroyer",
+  "size": 2,
+  "coreSize": "KK",
+  "sectionSizes": ["DB", "DS", "DS"],
+  "hullHealth": 400,
+  "evasion": 0.35,
+  "speed": 140,
+  "disengageChanceModifier": 1
+})"_json,
+                     ctx);
+  addComponent<model::component::Section>(components, R"({
+  "name": "Gunship",
+  "size": "DB",
+  "weaponSlots": "SS",
+  "utilitySlots": ""
+})"_json,
+                                          ctx);
+  addComponent<model::component::Section>(components, R"({
+  "name": "Picket",
+  "size": "DS",
+  "weaponSlots": "S",
+  "utilitySlots": ""
+})"_json,
+                                          ctx);
+  addComponent<model::component::Section>(components, R"({
+  "name": "Artillery",
+  "size": "DS",
+  "weaponSlots": "S",
+  "utilitySlots": ""
+})"_json,
+                                          ctx);
+  auto destroyer = [&components, &ctx](vector<json> const &sections) {
+    return Ship::fromJson(json{
+                              {"name", "Alpha"},
+                              {"hull", "Destroyer"},
+                              {"reactor", "Fission Reactor"},
+                              {"ftl", "Hyper Drive I"},
+                              {"sublight", "Chemical Thrusters"},
+                              {"sensor", "Radar System"},
+                              {"computer", "Basic Combat Computer"},
+                              {"sections", sections},
+                          },
+                          components, ctx);
+  };
+  auto section = [](string const &name, string const &weapon) {
+    return json{{"section", name},
+                {"weapons", {weapon}},
+                {"utilities", json::array()},
+                {"auxiliaries", json::array()}};
+  };
+  json gunship{{"section", "Gunship"},
+                   {"weapons", {"Small Mass Driver", "Small Red Laser"}},
+                   {"utilities", json::array()},
+                   {"auxiliaries", json::array()}};
+  Ship ship = destroyer({gunship, section("Picket", "Small Red Laser"),
+                         section("Artillery", "Small Mass Driver")});
+  Ship permuted = destroyer({section("Artillery", "Small Mass Driver"),
+                             section("Picket", "Small Red Laser"), gunship});
+  Ship refitted = destroyer({gunship, section("Picket", "Small Mass Driver"),
+                             section("Artillery", "Small Red Laser")});
+
+  REQUIRE_FALSE(ship.sameDesign(permuted));
+  REQUIRE(ship.canonical().sameDesign(permuted.canonical()));
+  REQUIRE_FALSE(ship.canonical().sameDesign(refitted.canonical()));
+
+  // by size, then by name
+  Ship canonical = permuted.canonical();
+  REQUIRE(canonical.sections.size() == 3);
+  REQUIRE(canonical.sections[0].section->name == "Gunship");
+  REQUIRE(canonical.sections[1].section->name == "Artillery");
+  REQUIRE(canonical.sections[2].section->name == "Picket");
+  REQUIRE(canonical.sameDesign(canonical.canonical()));
+}
+
+TEST_CASE("Ship validation", "[model][design][ship]") {
+  EvalContext ctx("root");
+  ComponentSet components = testComponents(ctx);
+  addComponent<Reactor>(components, R"({
+  "name": "Large Reactor",
+  "sizes": ["LL"],
+  "power": 1000,
+  "cost": {}
+})"_json,
+                        ctx);
+  addComponent<Reactor>(components, R"({
+  "name": "Weak Reactor",
+  "sizes": ["KK"],
+  "power": 10,
+  "cost": {}
+})"_json,
+                        ctx);
+  addComponent<Sublight>(components, R"({
+  "name": "Large Thrusters",
+  "sizes": ["LL"],
+  "power": -10,
+  "sublightSpeedModifier": 0,
+  "evasionBonus": 0,
+  "cost": {}
+})"_json,
+                         ctx);
+  addComponent<Computer>(components, R"({
+  "name": "Large Computer",
+  "sizes": ["LL"],
+  "tactics": "swarm",
+  "power": -5,
+  "cost": {}
+})"_json,
+                         ctx);
+  addComponent<Aura>(components, R"({
+  "name": "Large Aura",
+  "size": "LL"
+})"_json,
+                     ctx);
+  addComponent<Aura>(components, R"({
+  "name": "Small Aura",
+  "size": "KK"
+})"_json,
+                     ctx);
+
+  Hull const &hull = *components.getHull("Corvette");
+  Reactor const &reactor = *components.getReactor("Fission Reactor");
+  FTL const &ftl = *components.getFTL("Hyper Drive I");
+  Sublight const &sublight = *components.getSublight("Chemical Thrusters");
+  Sensor const &sensor = *components.getSensor("Radar System");
+  Computer const &computer = *components.getComputer("Basic Combat Computer");
+  Ship ship = Ship::fromJson(
+      testShipJson(
+          "Alpha", "Interceptor",
+          {"Small Red Laser", "Small Mass Driver", "Small Mass Driver"}),
+      components, ctx);
+  vector<model::design::Section> const &sections = ship.sections;
+
+  REQUIRE(Ship::validate(hull, reactor, ftl, sublight, sensor, computer,
+                         nullptr, sections) == DesignError::NONE);
+  REQUIRE(Ship::validate(hull, reactor, ftl, sublight, sensor, computer,
+                         components.getAura("Small Aura"),
+                         sections) == DesignError::NONE);
+
+  // the corvette has one section slot
+  REQUIRE(Ship::validate(hull, reactor, ftl, sublight, sensor, computer,
+                         nullptr, {sections[0], sections[0]}) ==
+          DesignError::SECTION_SLOTS);
+  // a section count past what a slot set holds can't wrap around to fit
+  REQUIRE(Ship::validate(hull, reactor, ftl, sublight, sensor, computer,
+                         nullptr,
+                         vector<model::design::Section>(256, sections[0])) ==
+          DesignError::SECTION_SLOTS);
+
+  REQUIRE(Ship::validate(hull, *components.getReactor("Large Reactor"), ftl,
+                         sublight, sensor, computer, nullptr,
+                         sections) == DesignError::REACTOR_SIZE);
+  REQUIRE(Ship::validate(hull, reactor, ftl,
+                         *components.getSublight("Large Thrusters"), sensor,
+                         computer, nullptr,
+                         sections) == DesignError::SUBLIGHT_SIZE);
+  REQUIRE(Ship::validate(hull, reactor, ftl, sublight, sensor,
+                         *components.getComputer("Large Computer"), nullptr,
+                         sections) == DesignError::COMPUTER_SIZE);
+  REQUIRE(Ship::validate(hull, reactor, ftl, sublight, sensor, computer,
+                         components.getAura("Large Aura"),
+                         sections) == DesignError::AURA_SIZE);
+
+  REQUIRE(Ship::validate(hull, *components.getReactor("Weak Reactor"), ftl,
+                         sublight, sensor, computer, nullptr,
+                         sections) == DesignError::POWER);
+  json weak = testShipJson(
+      "Alpha", "Interceptor",
+      {"Small Red Laser", "Small Mass Driver", "Small Mass Driver"});
+  weak["reactor"] = "Weak Reactor";
+  REQUIRE_THROWS(Ship::fromJson(weak, components, ctx));
+}
@@ -0,0 +1,84 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/design/shipRegistry.h"
+
+#include "catch2/catch_test_macros.hpp"
+#include "model/design/fleet.h"
+#include "model/testFleets.h"
+
+using namespace athena2;
+using namespace athena2::model::component;
+using namespace athena2::model::design;
+using namespace athena2::model::test;
+using namespace std;
+
+namespace {
+nlohmann::json testShips() {
+  return nlohmann::json::array(
+      {testShipJson("Alpha", "Interceptor",
+                    {"Small Red Laser", "Small Red Laser"}, {})});
+}
+}  // namespace
+
+TEST_CASE("Fleets share registry designs", "[model][design][shipRegistry]") {
+  EvalContext ctx("root");
+  ComponentSet components = testComponents(ctx);
+  ShipRegistry registry = ShipRegistry::fromJson(testShips(), components, ctx);
+  REQUIRE(registry.size() == 1);
+  REQUIRE(registry.get("Alpha"));
+  REQUIRE(registry.get("Beta") == nullptr);
+
+  Fleet first = Fleet::fromJson(R"({
+  "name": "First",
+  "ships": [{"ship": "Alpha", "count": 3}]
+})"_json,
+                                components, registry, ctx);
+  Fleet second = Fleet::fromJson(R"({
+  "name": "Second",
+  "ships": [{"ship": "Alpha", "count": 1}, {"ship": "Alpha", "count": 2}]
+})"_json,
+                                 components, registry, ctx);
+  REQUIRE(first.ships[0].first == registry.get("Alpha"));
+  REQUIRE(second.ships[1].first == registry.get("Alpha"));
+  REQUIRE(first.cost == second.cost);
+
+  Fleet canonical = second.canonical();
+  REQUIRE(canonical.ships.size() == 1);
+  REQUIRE(canonical.ships[0].first == registry.get("Alpha"));
+  REQUIRE(canonical.ships[0].second == 3);
+  REQUIRE(canonical.sameDesign(first.canonical()));
+}
+
+TEST_CASE("Ship registry errors", "[model][design][shipRegistry]") {
+  EvalContext ctx("root");
+  ComponentSet components = testComponents(ctx);
+  nlohmann::json ships = testShips();
+  ships.push_back(ships[0]);
+  REQUIRE_THROWS_WITH(ShipRegistry::fromJson(ships, components, ctx),
+                      "Error: root > 1: duplicate ship design Alpha");
+
+  ShipRegistry registry = ShipRegistry::fromJson(testShips(), components, ctx);
+  REQUIRE_THROWS_WITH(Fleet::fromJson(R"({
+  "name": "Fleet",
+  "ships": [{"ship": "Beta", "count": 1}]
+})"_json,
+                                      components, registry, ctx),
+                      "Error: root > 0 > ship: no such ship design 'Beta'");
+}
@@ -0,0 +1,111 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/entity/damage.h"
+
+#include "catch2/catch_test_macros.hpp"
+
+using namespace athena2::model::entity;
+using namespace std;
+
+namespace {
+Hit testHit(float damage, float shieldSkipModifier,
+            float hullDamageModifier) noexcept {
+  return Hit{
+      .damage = damage,
+      .shieldSkipModifier = shieldSkipModifier,
+      .shieldDamageModifier = 1.f,
+      .armourSkipModifier = 0.f,
+      .armourDamageModifier = 1.f,
+      .hullDamageModifier = hullDamageModifier,
+  };
+}
+}  // namespace
+
+TEST_CASE("Hits go through shields, then armour, then hull",
+          "[model][entity][damage]") {
+  Defences defences = {
+      .shields = 20.f,
+      .armour = 20.f,
+      .hull = 20.f,
+      .shieldHardening = 0.f,
+      .armourHardening = 0.f,
+  };
+  float hullDamage = 0.f;
+
+  REQUIRE(penetrate(testHit(10.f, 0.5f, 1.f), defences, hullDamage));
+  REQUIRE(defences.shields == 15.f);
+  REQUIRE(defences.armour == 15.f);
+  REQUIRE(defences.hull == 20.f);
+  REQUIRE(hullDamage == 0.f);
+
+  defences.armour = 0.f;
+  REQUIRE(penetrate(testHit(8.f, 1.f, 2.f), defences, hullDamage));
+  REQUIRE(defences.shields == 15.f);
+  REQUIRE(defences.hull == 4.f);
+  REQUIRE(hullDamage == 16.f);
+
+  REQUIRE_FALSE(penetrate(testHit(8.f, 1.f, 2.f), defences, hullDamage));
+  REQUIRE(defences.hull == 0.f);
+}
+
+TEST_CASE("Blocks of hits match hits one at a time",
+          "[model][entity][damage]") {
+  HitBlock<4> hits = {};
+  DefenceBlock<4> block = {};
+  Defences alone[4];
+  for (size_t lane = 0; lane < 4; ++lane) {
+    float scale = static_cast<float>(lane + 1);
+    Hit hit = testHit(6.f * scale, 0.25f * scale, 0.5f * scale);
+    hits.damage[lane] = hit.damage;
+    hits.shieldSkipModifier[lane] = hit.shieldSkipModifier;
+    hits.shieldDamageModifier[lane] = hit.shieldDamageModifier;
+    hits.armourSkipModifier[lane] = hit.armourSkipModifier;
+    hits.armourDamageModifier[lane] = hit.armourDamageModifier;
+    hits.hullDamageModifier[lane] = hit.hullDamageModifier;
+    alone[lane] = Defences{
+        .shields = 10.f,
+        .armour = 5.f,
+        .hull = 12.f,
+        .shieldHardening = 0.1f * scale,
+        .armourHardening = 0.2f,
+    };
+    block.shields[lane] = alone[lane].shields;
+    block.armour[lane] = alone[lane].armour;
+    block.hull[lane] = alone[lane].hull;
+    block.shieldHardening[lane] = alone[lane].shieldHardening;
+    block.armourHardening[lane] = alone[lane].armourHardening;
+  }
+
+  array<float, 4> hullDamage;
+  array<bool, 4> survives;
+  penetrate(hits, block, hullDamage, survives);
+  for (size_t lane = 0; lane < 4; ++lane) {
+    float scale = static_cast<float>(lane + 1);
+    float laneHullDamage = 0.f;
+    bool laneSurvives =
+        penetrate(testHit(6.f * scale, 0.25f * scale, 0.5f * scale),
+                  alone[lane], laneHullDamage);
+    REQUIRE(survives[lane] == laneSurvives);
+    REQUIRE(block.shields[lane] == alone[lane].shields);
+    REQUIRE(block.armour[lane] == alone[lane].armour);
+    REQUIRE(block.hull[lane] == alone[lane].hull);
+    if (laneSurvives) REQUIRE(hullDamage[lane] == laneHullDamage);
+  }
+}
@@ -0,0 +1,189 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/evaluator.h"
+
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "model/testFleets.h"
+
+using namespace athena2;
+using namespace athena2::model;
+using namespace athena2::model::component;
+using namespace athena2::model::design;
+using namespace athena2::model::test;
+using namespace std;
+
+namespace {
+/**
+ * gun, missile, and carrier fleets, which start out of each other's range
+ */
+vector<Fleet> testFleets(ComponentSet const &components, EvalContext &ctx) {
+  vector<Fleet> fleets;
+  fleets.push_back(testFleet(
+      "Guns", "Interceptor",
+      {"Small Red Laser", "Small Mass Driver", "Small Mass Driver"}, 4,
+      components, ctx));
+  fleets.push_back(testFleet(
+      "Missiles", "Interceptor",
+      {"Nuclear Missiles", "Nuclear Missiles", "Nuclear Missiles"}, 3,
+      components, ctx));
+  fleets.push_back(testFleet(
+      "Carriers", "Carrier",
+      {"Sentinel Point-Defence", "Small Mass Driver", "Scout Wing"}, 2,
+      components, ctx));
+  return fleets;
+}
+}  // namespace
+
+TEST_CASE("Adaptive time step doesn't change results",
+          "[model][evaluator]") {
+  EvalContext ctx("root");
+  ComponentSet components = testComponents(ctx);
+  vector<Fleet> fleets = testFleets(components, ctx);
+
+  size_t decisive = 0;
+  for (Fleet const &a : fleets) {
+    for (Fleet const &b : fleets) {
+      if (&a == &b) continue;
+      for (uint64_t seed = 1; seed <= 5; ++seed) {
+        EvaluationSettings stepped = testSettings(seed);
+        EvaluationSettings adaptive = stepped;
+        adaptive.adaptiveTimeStep = true;
+        EvaluationResult expected = evaluate(a, b, stepped);
+        EvaluationResult actual = evaluate(a, b, adaptive);
+        REQUIRE(actual.firstLoss == expected.firstLoss);
+        REQUIRE(actual.secondLoss == expected.secondLoss);
+        REQUIRE(actual.truncated == expected.truncated);
+        if (expected.firstLoss > 0.f || expected.secondLoss > 0.f) ++decisive;
+      }
+    }
+  }
+  // the fleets have to close in and fight for this to mean anything
+  REQUIRE(decisive > 0);
+}
+
+TEST_CASE("Early termination stays within half of epsilon",
+          "[model][evaluator]") {
+  EvalContext ctx("root");
+  ComponentSet components = testComponents(ctx);
+  vector<Fleet> fleets = testFleets(components, ctx);
+
+  size_t truncated = 0;
+  for (float epsilon : {50.f, 100.f, 150.f, 200.f}) {
+    for (Fleet const &a : fleets) {
+      for (Fleet const &b : fleets) {
+        if (&a == &b) continue;
+        for (uint64_t seed = 1; seed <= 5; ++seed) {
+          EvaluationSettings full = testSettings(seed);
+          EvaluationSettings early = full;
+          early.earlyTerminationEpsilon = epsilon;
+          EvaluationResult expected = evaluate(a, b, full);
+          EvaluationResult actual = evaluate(a, b, early);
+          REQUIRE(fabsf(actual.firstLoss - expected.firstLoss) <=
+                  epsilon / 2.f);
+          REQUIRE(fabsf(actual.secondLoss - expected.secondLoss) <=
+                  epsilon / 2.f);
+          if (actual.truncated) ++truncated;
+        }
+      }
+    }
+  }
+  REQUIRE(truncated > 0);
+}
+
+TEST_CASE("Sweeps match evaluating at each setting", "[model][evaluator]") {
+  EvalContext ctx("root");
+  ComponentSet components = testComponents(ctx);
+  vector<Fleet> fleets = testFleets(components, ctx);
+  vector<ScoringSettings> scorings = {
+      {.fightLengthLimit = 120.f, .withdrawMultiplier = 0.1f},
+      {.fightLengthLimit = 120.f, .withdrawMultiplier = 0.5f},
+      {.fightLengthLimit = 3.f, .withdrawMultiplier = 0.1f},
+      {.fightLengthLimit = 6.f, .withdrawMultiplier = 1.f},
+  };
+
+  for (Fleet const &a : fleets) {
+    for (Fleet const &b : fleets) {
+      if (&a == &b) continue;
+      for (size_t replicates : {size_t{1}, size_t{4}}) {
+        EvaluationSettings settings = testSettings(7);
+        settings.replicates = replicates;
+        vector<EvaluationResult> swept = evaluate(a, b, settings, scorings);
+        REQUIRE(swept.size() == scorings.size());
+        for (size_t idx = 0; idx < scorings.size(); ++idx) {
+          EvaluationSettings single = settings;
+          single.fightLengthLimit = scorings[idx].fightLengthLimit;
+          single.withdrawMultiplier = scorings[idx].withdrawMultiplier;
+          EvaluationResult expected = evaluate(a, b, single);
+          REQUIRE(swept[idx].firstLoss == expected.firstLoss);
+          REQUIRE(swept[idx].secondLoss == expected.secondLoss);
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("Fire threads don't change results", "[model][evaluator]") {
+  EvalContext ctx("root");
+  ComponentSet components = testComponents(ctx);
+  // big enough that targeting is shared out between the threads
+  Fleet guns = testFleet(
+      "Guns", "Interceptor",
+      {"Small Red Laser", "Small Mass Driver", "Small Mass Driver"}, 40,
+      components, ctx);
+  Fleet missiles = testFleet(
+      "Missiles", "Interceptor",
+      {"Nuclear Missiles", "Nuclear Missiles", "Small Red Laser"}, 30,
+      components, ctx);
+  Fleet carriers = testFleet(
+      "Carriers", "Carrier",
+      {"Sentinel Point-Defence", "Small Mass Driver", "Scout Wing"}, 20,
+      components, ctx);
+  vector<pair<Fleet const *, Fleet const *>> pairings = {
+      {&guns, &carriers}, {&missiles, &carriers}, {&carriers, &missiles}};
+
+  for (auto const &[a, b] : pairings) {
+    EvaluationSettings settings = testSettings(11);
+    settings.replicates = 3;
+    EvaluationResult expected = evaluate(*a, *b, settings);
+    FightTimeline expectedTimeline = simulate(*a, *b, settings);
+    REQUIRE((expected.firstLoss > 0.f || expected.secondLoss > 0.f));
+    for (size_t threads : {size_t{1}, size_t{4}}) {
+      settings.fireThreads = threads;
+      EvaluationResult actual = evaluate(*a, *b, settings);
+      REQUIRE(actual.firstLoss == expected.firstLoss);
+      REQUIRE(actual.secondLoss == expected.secondLoss);
+      REQUIRE(actual.truncated == expected.truncated);
+
+      FightTimeline timeline = simulate(*a, *b, settings);
+      REQUIRE(timeline.first.size() == expectedTimeline.first.size());
+      REQUIRE(timeline.second.size() == expectedTimeline.second.size());
+      for (size_t idx = 0; idx < timeline.first.size(); ++idx)
+        REQUIRE(timeline.first[idx].time == expectedTimeline.first[idx].time);
+      for (size_t idx = 0; idx < timeline.second.size(); ++idx)
+        REQUIRE(timeline.second[idx].time ==
+                expectedTimeline.second[idx].time);
+    }
+  }
+}
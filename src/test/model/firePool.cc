@@ -0,0 +1,45 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/firePool.h"
+
+#include <atomic>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+using namespace athena2::model;
+using namespace std;
+
+TEST_CASE("A pool runs every index exactly once per call", "[model][pool]") {
+  FirePool pool(4);
+  // the same pool serves call after call
+  for (size_t round = 0; round < 8; ++round) {
+    vector<atomic<size_t>> calls(100);
+    pool.forEach(calls.size(), [&calls](size_t idx) { ++calls[idx]; });
+    for (atomic<size_t> const &count : calls) REQUIRE(count == 1);
+  }
+}
+
+TEST_CASE("A pool of one thread runs inline", "[model][pool]") {
+  FirePool pool(1);
+  vector<size_t> order;
+  pool.forEach(5, [&order](size_t idx) { order.push_back(idx); });
+  REQUIRE(order == vector<size_t>{0, 1, 2, 3, 4});
+}
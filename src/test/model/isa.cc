@@ -0,0 +1,36 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/isa.h"
+
+#include "catch2/catch_test_macros.hpp"
+
+using namespace athena2::model;
+using namespace std;
+
+TEST_CASE("Instruction set names round trip", "[model][isa]") {
+  for (Isa isa : {Isa::BASELINE, Isa::SSE4_2, Isa::AVX2, Isa::AVX512})
+    REQUIRE(isaFromString(to_string(isa)) == isa);
+  REQUIRE_FALSE(isaFromString("avx1024").has_value());
+}
+
+TEST_CASE("Default instruction set is supported", "[model][isa]") {
+  REQUIRE(isaSupported(Isa::BASELINE));
+  REQUIRE(isaSupported(detectIsa()));
+}
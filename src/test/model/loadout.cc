@@ -0,0 +1,122 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/loadout.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "model/testFleets.h"
+
+using namespace athena2;
+using namespace athena2::model;
+using namespace athena2::model::component;
+using namespace athena2::model::test;
+using namespace std;
+
+TEST_CASE("Loadout stats dominance", "[model][loadout]") {
+  LoadoutStats a = {};
+  a.cost = 10.f;
+  a.hullDamage = 5.f;
+  LoadoutStats b = a;
+  REQUIRE_FALSE(a.dominates(b));
+  b.cost = 12.f;
+  REQUIRE(a.dominates(b));
+  REQUIRE_FALSE(b.dominates(a));
+  b.shieldHealth = 1.f;
+  REQUIRE_FALSE(a.dominates(b));
+  REQUIRE_FALSE(b.dominates(a));
+}
+
+TEST_CASE("Dominated section fillings are pruned", "[model][loadout]") {
+  EvalContext ctx("root");
+  ComponentSet components;
+  addComponent<model::component::Section>(components, R"({
+  "name": "Interceptor",
+  "size": "KC",
+  "weaponSlots": "SS",
+  "utilitySlots": ""
+})"_json,
+                                          ctx);
+  addComponent<Weapon>(components, testLaserJson("Cheap", 5.f, 10.f), ctx);
+  addComponent<Weapon>(components, testLaserJson("Strong", 10.f, 20.f), ctx);
+  addComponent<Weapon>(components, testLaserJson("Worse", 10.f, 10.f), ctx);
+
+  vector<SectionLoadouts> loadouts =
+      enumerateLoadouts(components, LoadoutSettings{
+                                        .threads = 2,
+                                        .maxCandidates = 0,
+                                        .minTier = 0,
+                                        .maxTier = 0,
+                                    });
+  REQUIRE(loadouts.size() == 1);
+  REQUIRE(loadouts[0].groups.size() == 1);
+  SlotGroup const &group = loadouts[0].groups[0];
+  REQUIRE(group.enumerated);
+  REQUIRE(group.options == 3);
+  REQUIRE(group.candidates() == 10.0);
+  // anything with "Worse" is beaten by swapping it for "Cheap"
+  for (SlotFilling const &filling : group.fillings) {
+    for (Weapon const *weapon : filling.weapons)
+      REQUIRE(weapon->name != "Worse");
+  }
+  // and two "Cheap" do what one "Strong" does for more power
+  REQUIRE(group.fillings.size() == 5);
+}
+
+TEST_CASE("Weapons that reach further or track better aren't pruned",
+          "[model][loadout]") {
+  EvalContext ctx("root");
+  ComponentSet components;
+  addComponent<model::component::Section>(components, R"({
+  "name": "Picket",
+  "size": "KC",
+  "weaponSlots": "S",
+  "utilitySlots": ""
+})"_json,
+                                          ctx);
+  addComponent<Weapon>(components, testLaserJson("Gun", 5.f, 20.f), ctx);
+  nlohmann::json railgun = testLaserJson("Railgun", 10.f, 10.f);
+  railgun["maxRange"] = 80;
+  addComponent<Weapon>(components, railgun, ctx);
+  nlohmann::json flak = testLaserJson("Flak", 10.f, 10.f);
+  flak["tracking"] = 0.9;
+  addComponent<Weapon>(components, flak, ctx);
+  addComponent<Weapon>(components, testLaserJson("Worse", 10.f, 10.f), ctx);
+
+  vector<SectionLoadouts> loadouts =
+      enumerateLoadouts(components, LoadoutSettings{
+                                        .threads = 1,
+                                        .maxCandidates = 0,
+                                        .minTier = 0,
+                                        .maxTier = 0,
+                                    });
+  REQUIRE(loadouts.size() == 1);
+  REQUIRE(loadouts[0].groups.size() == 1);
+  vector<string> kept;
+  for (SlotFilling const &filling : loadouts[0].groups[0].fillings) {
+    for (Weapon const *weapon : filling.weapons) kept.push_back(weapon->name);
+  }
+  sort(kept.begin(), kept.end());
+  // "Gun" out-damages the rest for less, but only "Worse" has nothing else
+  // going for it
+  REQUIRE(kept == vector<string>{"Flak", "Gun", "Railgun"});
+}
@@ -0,0 +1,96 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/lockstep.h"
+
+#include <string>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "model/evaluator.h"
+#include "model/isa.h"
+#include "model/testFleets.h"
+
+using namespace athena2;
+using namespace athena2::model;
+using namespace athena2::model::component;
+using namespace athena2::model::design;
+using namespace athena2::model::test;
+using namespace std;
+
+TEST_CASE("Lockstep replicates match fighting each alone",
+          "[model][lockstep]") {
+  EvalContext ctx("root");
+  ComponentSet components = testComponents(ctx);
+  Fleet lasers = testFleet("Lasers", "Interceptor",
+                           vector<string>(3, "Small Red Laser"), 5,
+                           components, ctx);
+  Fleet drivers = testFleet("Drivers", "Interceptor",
+                            vector<string>(3, "Small Mass Driver"), 4,
+                            components, ctx);
+  REQUIRE(lockstepable(lasers, drivers));
+
+  EvaluationSettings settings = testSettings(42);
+  settings.replicates = 19;
+  settings.antitheticPairs = true;
+  vector<EvaluationSettings> replicates;
+  for (size_t idx = 0; idx < settings.replicates; ++idx)
+    replicates.push_back(replicate(settings, idx));
+
+  vector<EvaluationResult> results =
+      fightLockstep(lasers, drivers, 60.f, replicates);
+  REQUIRE(results.size() == replicates.size());
+  for (size_t idx = 0; idx < replicates.size(); ++idx) {
+    EvaluationResult alone = evaluate(lasers, drivers, replicates[idx]);
+    REQUIRE(results[idx].firstLoss == alone.firstLoss);
+    REQUIRE(results[idx].secondLoss == alone.secondLoss);
+  }
+}
+
+TEST_CASE("Lockstep results don't depend on the instruction set",
+          "[model][lockstep]") {
+  EvalContext ctx("root");
+  ComponentSet components = testComponents(ctx);
+  Fleet lasers = testFleet("Lasers", "Interceptor",
+                           vector<string>(3, "Small Red Laser"), 5,
+                           components, ctx);
+  Fleet drivers = testFleet("Drivers", "Interceptor",
+                            vector<string>(3, "Small Mass Driver"), 4,
+                            components, ctx);
+
+  EvaluationSettings settings = testSettings(42);
+  settings.replicates = 11;
+  vector<EvaluationSettings> replicates;
+  for (size_t idx = 0; idx < settings.replicates; ++idx)
+    replicates.push_back(replicate(settings, idx));
+  vector<EvaluationResult> baseline =
+      fightLockstep(lasers, drivers, 60.f, replicates);
+
+  for (Isa isa : {Isa::SSE4_2, Isa::AVX2, Isa::AVX512}) {
+    if (!isaSupported(isa)) continue;
+    for (EvaluationSettings &single : replicates) single.isa = isa;
+    vector<EvaluationResult> results =
+        fightLockstep(lasers, drivers, 60.f, replicates);
+    for (size_t idx = 0; idx < replicates.size(); ++idx) {
+      REQUIRE(results[idx].firstLoss == baseline[idx].firstLoss);
+      REQUIRE(results[idx].secondLoss == baseline[idx].secondLoss);
+      REQUIRE(results[idx].truncated == baseline[idx].truncated);
+    }
+  }
+}
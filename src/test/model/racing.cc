@@ -0,0 +1,116 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/racing.h"
+
+#include <cstddef>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "model/testFleets.h"
+
+using namespace athena2;
+using namespace athena2::model;
+using namespace athena2::model::component;
+using namespace athena2::model::design;
+using namespace athena2::model::test;
+using namespace std;
+
+TEST_CASE("Racing", "[model][racing]") {
+  EvalContext ctx("root");
+  ComponentSet components = testComponents(ctx);
+  vector<string> guns = {"Small Red Laser", "Small Mass Driver",
+                         "Small Mass Driver"};
+  // candidate i has i + 1 ships, so the last is the strongest
+  vector<Fleet> fleets;
+  fleets.reserve(6);
+  for (size_t count = 1; count <= 5; ++count)
+    fleets.push_back(testFleet("Guns " + to_string(count), "Interceptor",
+                               guns, count, components, ctx));
+  fleets.push_back(testFleet(
+      "Missiles", "Interceptor",
+      {"Nuclear Missiles", "Nuclear Missiles", "Nuclear Missiles"}, 3,
+      components, ctx));
+  vector<Fleet const *> candidates;
+  for (size_t idx = 0; idx < 5; ++idx) candidates.push_back(&fleets[idx]);
+  // the middle candidate is also an opponent
+  vector<Fleet const *> opponents = {&fleets[2], &fleets[5]};
+
+  RacingSettings racing = {
+      .initialFights = 2,
+      .keepFraction = 0.5f,
+      .fightBudget = 0,
+      .timeBudget = 0.f,
+  };
+  FirePool pool(1);
+
+  SECTION("strongest ranks first") {
+    RacingResult result =
+        race(candidates, opponents, testSettings(42), racing, pool);
+    REQUIRE_FALSE(result.stoppedEarly);
+    REQUIRE(result.ranking.size() == candidates.size());
+    REQUIRE(result.ranking.front() == 4);
+    // every candidate played the first round, and survivors played more
+    for (size_t idx = 0; idx < candidates.size(); ++idx)
+      REQUIRE(result.fights[idx] >= racing.initialFights);
+    REQUIRE(result.fights[4] > result.fights[result.ranking.back()]);
+  }
+
+  SECTION("candidates don't fight themselves") {
+    racing.keepFraction = 1.f;
+    RacingResult result =
+        race(candidates, opponents, testSettings(42), racing, pool);
+    REQUIRE(result.fights[2] == racing.initialFights);
+    REQUIRE(result.fights[0] == 2 * racing.initialFights);
+  }
+
+  SECTION("fight budget is never exceeded") {
+    for (size_t budget : {1, 5, 13, 40}) {
+      racing.fightBudget = budget;
+      RacingResult result =
+          race(candidates, opponents, testSettings(42), racing, pool);
+      REQUIRE(accumulate(result.fights.begin(), result.fights.end(),
+                         size_t{0}) <= budget);
+      REQUIRE(result.ranking.size() == candidates.size());
+    }
+  }
+
+  SECTION("unfinished candidates keep their previous order") {
+    // the first candidate finishes its round, the second is cut short, and
+    // the rest never start
+    racing.fightBudget = 5;
+    RacingResult result =
+        race(candidates, opponents, testSettings(42), racing, pool);
+    REQUIRE(result.stoppedEarly);
+    REQUIRE(result.fights[0] == 4);
+    REQUIRE(result.fights[1] == 1);
+    REQUIRE(result.ranking == vector<size_t>{0, 1, 2, 3, 4});
+  }
+
+  SECTION("time budget stops early") {
+    racing.initialFights = 1000;
+    racing.timeBudget = 1e-6f;
+    RacingResult result =
+        race(candidates, opponents, testSettings(42), racing, pool);
+    REQUIRE(result.stoppedEarly);
+    REQUIRE(result.ranking.size() == candidates.size());
+  }
+}
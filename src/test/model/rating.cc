@@ -0,0 +1,108 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/rating.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "model/testFleets.h"
+
+using namespace athena2;
+using namespace athena2::model;
+using namespace athena2::model::component;
+using namespace athena2::model::design;
+using namespace athena2::model::test;
+using namespace std;
+using namespace nlohmann;
+
+TEST_CASE("Rating again plays only new fights", "[model][rating]") {
+  EvalContext ctx("root");
+  ComponentSet components = testComponents(ctx);
+  vector<Fleet> fleets;
+  for (size_t count = 1; count <= 4; ++count)
+    fleets.push_back(testFleet("Guns " + to_string(count), "Interceptor",
+                               {"Small Red Laser", "Small Mass Driver",
+                                "Small Mass Driver"},
+                               count, components, ctx));
+  vector<Fleet const *> pool;
+  for (Fleet const &fleet : fleets) pool.push_back(&fleet);
+  EvaluationSettings settings = testSettings(42);
+  FirePool firePool(1);
+  string filename =
+      (filesystem::temp_directory_path() / "athena2-rating-test.bin").string();
+  remove(filename.c_str());
+  ResultCache cache = ResultCache::open(filename, components, ctx);
+
+  vector<Rating> ratings(pool.size(), INITIAL_RATING);
+  playSwiss(pool, ratings, settings, swissRounds(pool.size()), firePool,
+            &cache);
+  vector<Rating> first = ratings;
+  REQUIRE(cache.hits == 0);
+  REQUIRE(cache.misses == pool.size());
+
+  // every fight counted the second time round is a fight not seen before
+  playSwiss(pool, ratings, settings, swissRounds(pool.size()), firePool,
+            &cache);
+  remove(filename.c_str());
+  REQUIRE(cache.hits == 0);
+  REQUIRE(cache.misses == 2 * pool.size());
+  for (size_t idx = 0; idx < pool.size(); ++idx) {
+    REQUIRE(ratings[idx].fights == first[idx].fights + 2);
+    REQUIRE(ratings[idx].deviation < first[idx].deviation);
+    size_t recorded = 0;
+    for (auto const &[name, fights] : ratings[idx].opponents) {
+      REQUIRE(name != pool[idx]->name);
+      recorded += fights;
+    }
+    REQUIRE(recorded == ratings[idx].fights);
+  }
+}
+
+TEST_CASE("Ratings round trip through JSON", "[model][rating]") {
+  EvalContext ctx("root");
+  Rating rating = {
+      .rating = 1600.f,
+      .deviation = 100.f,
+      .fights = 3,
+      .opponents = {{"A", 2}, {"B", 1}},
+  };
+  Rating read = Rating::fromJson(static_cast<json>(rating), ctx);
+  REQUIRE(read.rating == rating.rating);
+  REQUIRE(read.deviation == rating.deviation);
+  REQUIRE(read.fights == rating.fights);
+  REQUIRE(read.opponents == rating.opponents);
+
+  // tables from before opponents were recorded still load
+  Rating old = Rating::fromJson(
+      json{{"rating", 1500.f}, {"deviation", 350.f}, {"fights", 0}}, ctx);
+  REQUIRE(old.opponents.empty());
+
+  REQUIRE_THROWS_WITH(
+      Rating::fromJson(json{{"rating", 1500.f},
+                            {"deviation", 350.f},
+                            {"fights", 0},
+                            {"opponents", {{"A", -1}}}},
+                       ctx),
+      "Error: root > opponents > A: value must be positive");
+}
@@ -0,0 +1,92 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/rng.h"
+
+#include <array>
+#include <cmath>
+
+#include "catch2/catch_test_macros.hpp"
+
+using namespace athena2::model;
+using namespace std;
+
+TEST_CASE("Same seed gives same numbers", "[model][rng]") {
+  Rng a(42);
+  Rng b(42);
+  for (size_t idx = 0; idx < 16; ++idx) REQUIRE(a() == b());
+}
+
+TEST_CASE("Streams depend only on seed and key", "[model][rng]") {
+  Rng a(42);
+  Rng b(42);
+  b();
+  b();
+  REQUIRE(a.stream(7)() == b.stream(7)());
+  REQUIRE(a.stream(7)() != a.stream(8)());
+  REQUIRE(a.stream(7).stream(3)() == b.stream(7).stream(3)());
+}
+
+TEST_CASE("Antithetic numbers are complements", "[model][rng]") {
+  Rng a(42);
+  Rng b(42, true);
+  REQUIRE(a.stream(7)() == ~b.stream(7)());
+  for (size_t idx = 0; idx < 16; ++idx) REQUIRE(a() == ~b());
+}
+
+TEST_CASE("Blocks match drawing one at a time", "[model][rng]") {
+  Rng a(42);
+  Rng b(42);
+  array<float, 13> block;
+  a.fill(block);
+  for (float number : block) REQUIRE(number == b.uniform());
+  REQUIRE(a() == b());
+}
+
+TEST_CASE("Uniform floats are in range", "[model][rng]") {
+  Rng a(42);
+  Rng b(42, true);
+  for (size_t idx = 0; idx < 1024; ++idx) {
+    float number = a.uniform();
+    REQUIRE(number >= 0.f);
+    REQUIRE(number < 1.f);
+    // antithetic floats are complements, up to the last bit
+    REQUIRE(number + b.uniform() == 1.f - 0x1p-24f);
+  }
+  float number = a.uniform(2.f, 3.f);
+  REQUIRE(number >= 2.f);
+  REQUIRE(number < 3.f);
+
+  // a range one float wide would round up to max about half the time
+  float next = nextafterf(1.f, 2.f);
+  for (size_t idx = 0; idx < 64; ++idx) REQUIRE(a.uniform(1.f, next) == 1.f);
+  REQUIRE(a.uniform(1.f, 1.f) == 1.f);
+}
+
+TEST_CASE("Bernoulli trials have the given chance", "[model][rng]") {
+  Rng a(42);
+  size_t successes = 0;
+  for (size_t idx = 0; idx < 10000; ++idx)
+    if (a.bernoulli(0.25f)) ++successes;
+  REQUIRE(successes > 2300);
+  REQUIRE(successes < 2700);
+  REQUIRE_FALSE(a.bernoulli(0.f));
+  REQUIRE(a.bernoulli(1.f));
+  REQUIRE(a.bernoulli(1.5f));
+}
@@ -0,0 +1,104 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/sequential.h"
+
+#include "catch2/catch_test_macros.hpp"
+#include "model/testFleets.h"
+
+using namespace athena2;
+using namespace athena2::model;
+using namespace athena2::model::component;
+using namespace athena2::model::design;
+using namespace athena2::model::test;
+using namespace std;
+
+namespace {
+SequentialSettings testSequential() noexcept {
+  return SequentialSettings{
+      .alpha = 0.05f,
+      .beta = 0.05f,
+      .winProbability = 0.8f,
+      .intervalWidth = 0.f,
+      .minFights = 1,
+      .maxFights = 100,
+  };
+}
+}  // namespace
+
+TEST_CASE("Sequential comparison stops early on a clear winner",
+          "[model][sequential]") {
+  EvalContext ctx("root");
+  ComponentSet components = testComponents(ctx);
+  vector<string> guns = {"Small Red Laser", "Small Mass Driver",
+                         "Small Mass Driver"};
+  Fleet many = testFleet("Many", "Interceptor", guns, 6, components, ctx);
+  Fleet few = testFleet("Few", "Interceptor", guns, 1, components, ctx);
+  SequentialSettings sequential = testSequential();
+  FirePool pool(1);
+
+  SequentialResult first =
+      compareSequentially(many, few, testSettings(42), sequential, pool);
+  REQUIRE(first.verdict == SequentialResult::Verdict::FIRST);
+  REQUIRE(first.fights < sequential.maxFights);
+  REQUIRE(first.mean.firstLoss < first.mean.secondLoss);
+
+  SequentialResult second =
+      compareSequentially(few, many, testSettings(42), sequential, pool);
+  REQUIRE(second.verdict == SequentialResult::Verdict::SECOND);
+  REQUIRE(second.fights < sequential.maxFights);
+
+  SECTION("minFights") {
+    sequential.minFights = 12;
+    SequentialResult bounded =
+        compareSequentially(many, few, testSettings(42), sequential, pool);
+    REQUIRE(bounded.verdict == SequentialResult::Verdict::FIRST);
+    REQUIRE(bounded.fights == sequential.minFights);
+  }
+}
+
+TEST_CASE("Sequential comparison of identical fleets", "[model][sequential]") {
+  EvalContext ctx("root");
+  ComponentSet components = testComponents(ctx);
+  Fleet a = testFleet("A", "Interceptor",
+                      {"Small Red Laser", "Small Mass Driver",
+                       "Small Mass Driver"},
+                      3, components, ctx);
+  SequentialSettings sequential = testSequential();
+  FirePool pool(1);
+
+  SECTION("is never a win") {
+    SequentialResult result =
+        compareSequentially(a, a, testSettings(42), sequential, pool);
+    REQUIRE(result.verdict != SequentialResult::Verdict::FIRST);
+    REQUIRE(result.verdict != SequentialResult::Verdict::SECOND);
+    REQUIRE(result.fights <= sequential.maxFights);
+  }
+
+  SECTION("runs to maxFights when no test can finish") {
+    // thresholds this far out can't be crossed in maxFights fights
+    sequential.alpha = 1e-30f;
+    sequential.beta = 1e-30f;
+    sequential.maxFights = 8;
+    SequentialResult result =
+        compareSequentially(a, a, testSettings(42), sequential, pool);
+    REQUIRE(result.verdict == SequentialResult::Verdict::UNDECIDED);
+    REQUIRE(result.fights == sequential.maxFights);
+  }
+}
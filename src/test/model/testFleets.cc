@@ -0,0 +1,272 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "model/testFleets.h"
+
+using namespace std;
+using namespace athena2::model::component;
+using namespace athena2::model::design;
+using namespace nlohmann;
+
+namespace athena2::model::test {
+ComponentSet testComponents(EvalContext &ctx) {
+  ComponentSet components;
+  addComponent<Hull>(components, R"({
+  "name": "Corvette",
+  "size": 1,
+  "coreSize": "KK",
+  "sectionSizes": ["KC"],
+  "hullHealth": 200,
+  "evasion": 0.6,
+  "speed": 160,
+  "disengageChanceModifier": 1
+})"_json,
+                     ctx);
+  addComponent<component::Section>(components, R"({
+  "name": "Interceptor",
+  "size": "KC",
+  "weaponSlots": "SSS",
+  "utilitySlots": "SSSA"
+})"_json,
+                                   ctx);
+  addComponent<component::Section>(components, R"({
+  "name": "Carrier",
+  "size": "KC",
+  "weaponSlots": "PSH",
+  "utilitySlots": "SS"
+})"_json,
+                                   ctx);
+  addComponent<Reactor>(components, R"({
+  "name": "Fission Reactor",
+  "sizes": ["KK"],
+  "power": 100,
+  "cost": {}
+})"_json,
+                        ctx);
+  addComponent<FTL>(components, R"({
+  "name": "Hyper Drive I",
+  "power": -10,
+  "disengageChances": 1,
+  "cost": {}
+})"_json,
+                    ctx);
+  addComponent<Sublight>(components, R"({
+  "name": "Chemical Thrusters",
+  "sizes": ["KK"],
+  "power": -10,
+  "sublightSpeedModifier": 0,
+  "evasionBonus": 0,
+  "cost": {}
+})"_json,
+                         ctx);
+  addComponent<Sensor>(components, R"({
+  "name": "Radar System",
+  "power": -5,
+  "trackingBonus": 0,
+  "cost": {}
+})"_json,
+                       ctx);
+  addComponent<Computer>(components, R"({
+  "name": "Basic Combat Computer",
+  "sizes": ["KK"],
+  "tactics": "swarm",
+  "power": -5,
+  "cost": {}
+})"_json,
+                         ctx);
+  addComponent<Weapon>(components, R"({
+  "name": "Small Red Laser",
+  "size": "S",
+  "tag": "energy",
+  "power": -5,
+  "minDamage": 6,
+  "maxDamage": 16,
+  "cooldown": 4.25,
+  "accuracy": 0.9,
+  "tracking": 0.5,
+  "minRange": 0,
+  "maxRange": 40,
+  "shieldDamageModifier": 1,
+  "armourDamageModifier": 1,
+  "hullDamageModifier": 1,
+  "cost": {"alloys": 10}
+})"_json,
+                       ctx);
+  addComponent<Weapon>(components, R"({
+  "name": "Small Mass Driver",
+  "size": "S",
+  "tag": "kinetic",
+  "power": -5,
+  "minDamage": 4,
+  "maxDamage": 13,
+  "cooldown": 3,
+  "accuracy": 0.9,
+  "tracking": 0.5,
+  "minRange": 0,
+  "maxRange": 60,
+  "armourDamageModifier": 0.5,
+  "shieldDamageModifier": 1.5,
+  "hullDamageModifier": 1,
+  "cost": {"alloys": 10}
+})"_json,
+                       ctx);
+  addComponent<Weapon>(components, R"({
+  "name": "Nuclear Missiles",
+  "size": "S",
+  "tag": "explosive",
+  "power": -5,
+  "minDamage": 16,
+  "maxDamage": 24,
+  "cooldown": 8.5,
+  "accuracy": 1,
+  "tracking": 0.25,
+  "minRange": 0,
+  "maxRange": 100,
+  "shieldSkipModifier": 1,
+  "projectileHull": 3,
+  "projectileArmour": 3,
+  "projectileEvasion": 0,
+  "projectileSpeed": 400,
+  "projectileRetargetRange": 100,
+  "shieldDamageModifier": 1,
+  "armourDamageModifier": 1,
+  "hullDamageModifier": 1,
+  "cost": {"alloys": 10}
+})"_json,
+                       ctx);
+  addComponent<Weapon>(components, R"({
+  "name": "Sentinel Point-Defence",
+  "size": "P",
+  "tag": "point-defence",
+  "power": -5,
+  "minDamage": 2,
+  "maxDamage": 4,
+  "cooldown": 0.5,
+  "accuracy": 0.75,
+  "tracking": 0.1,
+  "minRange": 0,
+  "maxRange": 30,
+  "shieldDamageModifier": 0.25,
+  "armourSkipModifier": 0.25,
+  "armourDamageModifier": 2,
+  "hullDamageModifier": 1,
+  "cost": {"alloys": 8}
+})"_json,
+                       ctx);
+  addComponent<Weapon>(components, R"({
+  "name": "Scout Wing",
+  "size": "H",
+  "tag": "hangar",
+  "power": -20,
+  "minDamage": 4,
+  "maxDamage": 8,
+  "cooldown": 2.3,
+  "accuracy": 1,
+  "tracking": 0.7,
+  "minRange": 0,
+  "maxRange": 125,
+  "shieldSkipModifier": 1,
+  "armourDamageModifier": 1.5,
+  "unitsPerHangar": 8,
+  "regenerationPerDay": 0.5,
+  "strikeCraftRange": 10,
+  "strikeCraftHull": 5,
+  "strikeCraftArmour": 0,
+  "strikeCraftShield": 10,
+  "strikeCraftEvasion": 0.6,
+  "strikeCraftSpeed": 550,
+  "shieldDamageModifier": 1,
+  "hullDamageModifier": 1,
+  "cost": {"alloys": 40}
+})"_json,
+                       ctx);
+  addComponent<Utility>(components, R"({
+  "name": "Small Deflectors",
+  "size": "S",
+  "power": -15,
+  "shieldHealth": 75,
+  "shieldRegen": 0.5,
+  "cost": {"alloys": 10}
+})"_json,
+                        ctx);
+  return components;
+}
+
+json testShipJson(string const &name, string const &section,
+                  vector<string> const &weapons,
+                  vector<string> const &utilities,
+                  vector<string> const &auxiliaries) {
+  json ship = R"({
+  "hull": "Corvette",
+  "reactor": "Fission Reactor",
+  "ftl": "Hyper Drive I",
+  "sublight": "Chemical Thrusters",
+  "sensor": "Radar System",
+  "computer": "Basic Combat Computer",
+  "sections": [{}]
+})"_json;
+  ship["name"] = name;
+  ship["sections"][0]["section"] = section;
+  ship["sections"][0]["weapons"] = weapons;
+  ship["sections"][0]["utilities"] = utilities;
+  ship["sections"][0]["auxiliaries"] = auxiliaries;
+  return ship;
+}
+json testLaserJson(string const &name, float cost, float maxDamage) {
+  json data = R"({
+  "size": "S",
+  "tag": "energy",
+  "power": -5,
+  "minDamage": 0,
+  "cooldown": 1,
+  "accuracy": 1,
+  "tracking": 0,
+  "minRange": 0,
+  "maxRange": 40
+})"_json;
+  data["name"] = name;
+  data["maxDamage"] = maxDamage;
+  data["cost"] = {{"alloys", cost}};
+  return data;
+}
+Fleet testFleet(string const &name, string const &section,
+                vector<string> const &weapons, size_t count,
+                ComponentSet const &components, EvalContext &ctx) {
+  json fleet = R"({"ships": [{}]})"_json;
+  fleet["name"] = name;
+  fleet["ships"][0]["ship"] = testShipJson(name, section, weapons);
+  fleet["ships"][0]["count"] = count;
+  return Fleet::fromJson(fleet, components, ctx);
+}
+EvaluationSettings testSettings(uint64_t seed) noexcept {
+  return EvaluationSettings{
+      .fightLengthLimit = 120.f,
+      .withdrawMultiplier = 0.1f,
+      .debugDump = false,
+      .adaptiveTimeStep = false,
+      .earlyTerminationEpsilon = 0.f,
+      .seed = seed,
+      .antithetic = false,
+      .replicates = 1,
+      .antitheticPairs = false,
+      .fireThreads = 0,
+      .isa = Isa::BASELINE,
+  };
+}
+}  // namespace athena2::model::test
@@ -0,0 +1,90 @@
+// Copyright 2023 Justin Hu
+//
+// This file is part of Athena II.
+//
+// Athena II is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free
+// Software Foundation, either version 3 of the License, or (at your option)
+// any later version.
+//
+// Athena II is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// Athena II. If not, see <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ATHENA2_TEST_MODEL_TESTFLEETS_H_
+#define ATHENA2_TEST_MODEL_TESTFLEETS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "dsl.h"
+#include "model/component/componentSet.h"
+#include "model/design/fleet.h"
+#include "model/evaluator.h"
+#include "nlohmann/json.hpp"
+#include "util/hash.h"
+
+namespace athena2::model::test {
+/**
+ * add a component hashed the way loaded components are
+ */
+template <typename T>
+void addComponent(component::ComponentSet &components,
+                  nlohmann::json const &data, EvalContext &ctx,
+                  unsigned tier = 0) {
+  components.add(T::fromJson(data, ctx), ctx, util::hashBytes(data.dump()),
+                 tier);
+}
+
+/**
+ * corvette components covering every kind of weapon: two guns, a missile, a
+ * point-defence gun, and a hangar
+ *
+ * sections are "Interceptor" (SSS weapons) and "Carrier" (PSH weapons); every
+ * weapon has positive damage modifiers against every layer
+ */
+component::ComponentSet testComponents(EvalContext &);
+
+/**
+ * json for a corvette with one section of the given type holding the given
+ * weapons, utilities, and auxiliaries
+ */
+nlohmann::json testShipJson(
+    std::string const &name, std::string const &section,
+    std::vector<std::string> const &weapons,
+    std::vector<std::string> const &utilities = {"Small Deflectors"},
+    std::vector<std::string> const &auxiliaries = {});
+
+/**
+ * json for a small laser that always hits and never tracks, doing up to
+ * maxDamage every day out to 40 range
+ */
+nlohmann::json testLaserJson(std::string const &name, float cost,
+                             float maxDamage);
+
+/**
+ * a fleet of count corvettes, each with one section of the given type holding
+ * the given weapons and a deflector
+ */
+design::Fleet testFleet(std::string const &name, std::string const &section,
+                        std::vector<std::string> const &weapons,
+                        std::size_t count,
+                        component::ComponentSet const &components,
+                        EvalContext &ctx);
+
+/**
+ * settings for one unadorned fight on the baseline kernel: 120 days, a 0.1
+ * withdraw multiplier, fixed steps, no early termination, and one thread
+ */
+EvaluationSettings testSettings(std::uint64_t seed) noexcept;
+}  // namespace athena2::model::test
+
+#endif  // ATHENA2_TEST_MODEL_TESTFLEETS_H_